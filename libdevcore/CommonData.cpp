@@ -108,7 +108,7 @@ bytes dev::fromHex(std::string const& _s, WhenError _throw)
 	return ret;
 }
 
-/*bytes dev::asNibbles(bytesConstRef const& _s)
+bytes dev::asNibbles(bytesConstRef const& _s)
 {
 	std::vector<uint8_t> ret;
 	ret.reserve(_s.size() * 2);
@@ -118,7 +118,7 @@ bytes dev::fromHex(std::string const& _s, WhenError _throw)
 		ret.push_back(i % 16);
 	}
 	return ret;
-}*/
+}
 
 std::string dev::toString(string32 const& _s)
 {
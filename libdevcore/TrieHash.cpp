@@ -0,0 +1,148 @@
+/*
+	This file is part of cpp-ethereum.
+
+	cpp-ethereum is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	cpp-ethereum is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with cpp-ethereum.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file TrieHash.cpp
+ */
+
+#include "TrieHash.h"
+#include "RLP.h"
+#include "SHA3.h"
+using namespace std;
+
+namespace dev
+{
+
+h256 const EmptyTrie = sha3(rlp(""));
+
+namespace
+{
+
+/// Trie paths as nibbles => values
+using HexMap = std::map<bytes, bytes>;
+
+void hash256aux(HexMap::const_iterator _begin, HexMap::const_iterator _end, unsigned _preLen, RLPStream& _rlp);
+
+/// Append the node of all entries in [_begin, _end) that share the first _preLen nibbles
+void hash256rlp(HexMap::const_iterator _begin, HexMap::const_iterator _end, unsigned _preLen, RLPStream& _rlp)
+{
+	if (_begin == _end)
+		_rlp << "";
+	else if (std::next(_begin) == _end)
+	{
+		// only one left - terminate with the pair
+		_rlp.appendList(2) << hexPrefixEncode(_begin->first, true, _preLen) << _begin->second;
+	}
+	else
+	{
+		// the number of nibbles all the entries share, entries are sorted so the first is compared with each
+		unsigned sharedPre = (unsigned)-1;
+		for (auto i = std::next(_begin); i != _end && sharedPre; ++i)
+		{
+			unsigned const x = std::min(sharedPre, std::min((unsigned)_begin->first.size(), (unsigned)i->first.size()));
+			unsigned shared = _preLen;
+			for (; shared < x && _begin->first[shared] == i->first[shared]; ++shared) {}
+			sharedPre = std::min(shared, sharedPre);
+		}
+		if (sharedPre > _preLen)
+		{
+			// extension node over the shared nibbles
+			_rlp.appendList(2) << hexPrefixEncode(_begin->first, false, _preLen, (int)sharedPre);
+			hash256aux(_begin, _end, sharedPre, _rlp);
+		}
+		else
+		{
+			// branch node, 16 children and the value of the path ending here
+			_rlp.appendList(17);
+			auto b = _begin;
+			if (_preLen == b->first.size())
+				++b;
+			for (unsigned i = 0; i < 16; ++i)
+			{
+				auto n = b;
+				for (; n != _end && n->first[_preLen] == i; ++n) {}
+				if (b == n)
+					_rlp << "";
+				else
+					hash256aux(b, n, _preLen + 1, _rlp);
+				b = n;
+			}
+			if (_preLen == _begin->first.size())
+				_rlp << _begin->second;
+			else
+				_rlp << "";
+		}
+	}
+}
+
+/// Append the child node, inlined if its rlp is shorter than a hash
+void hash256aux(HexMap::const_iterator _begin, HexMap::const_iterator _end, unsigned _preLen, RLPStream& _rlp)
+{
+	RLPStream rlp;
+	hash256rlp(_begin, _end, _preLen, rlp);
+	if (rlp.out().size() < 32)
+		_rlp.appendRaw(rlp.out());
+	else
+		_rlp << sha3(rlp.out());
+}
+
+}
+
+std::string hexPrefixEncode(bytes const& _nibbles, bool _leaf, int _begin, int _end)
+{
+	unsigned begin = _begin;
+	unsigned const end = _end < 0 ? _nibbles.size() + 1 + _end : _end;
+	bool const odd = ((end - begin) % 2) != 0;
+
+	std::string ret(1, ((_leaf ? 2 : 0) | (odd ? 1 : 0)) * 16);
+	if (odd)
+	{
+		ret[0] |= _nibbles[begin];
+		++begin;
+	}
+	for (unsigned i = begin; i < end; i += 2)
+		ret += _nibbles[i] * 16 + _nibbles[i + 1];
+	return ret;
+}
+
+h256 trieRoot(BytesMap const& _data)
+{
+	if (_data.empty())
+		return EmptyTrie;
+	HexMap hexMap;
+	for (auto const& [key, value] : _data)
+		hexMap[asNibbles(bytesConstRef(&key))] = value;
+	RLPStream s;
+	hash256rlp(hexMap.cbegin(), hexMap.cend(), 0, s);
+	return sha3(s.out());
+}
+
+h256 secureTrieRoot(BytesMap const& _data)
+{
+	BytesMap hashed;
+	for (auto const& [key, value] : _data)
+		hashed[sha3(key).asBytes()] = value;
+	return trieRoot(hashed);
+}
+
+h256 orderedTrieRoot(std::vector<bytes> const& _data)
+{
+	BytesMap data;
+	for (size_t i = 0; i < _data.size(); ++i)
+		data[rlp((unsigned)i)] = _data[i];
+	return trieRoot(data);
+}
+
+}
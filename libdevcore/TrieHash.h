@@ -0,0 +1,48 @@
+/*
+	This file is part of cpp-ethereum.
+
+	cpp-ethereum is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	cpp-ethereum is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with cpp-ethereum.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file TrieHash.h
+ * Root hash of a Merkle Patricia trie built in memory from all of its key/value pairs.
+ */
+
+#pragma once
+
+#include <map>
+#include "Common.h"
+#include "FixedHash.h"
+
+namespace dev
+{
+
+/// Key/value pairs of a trie. Keys are the raw trie paths, hash them first for a secure trie.
+using BytesMap = std::map<bytes, bytes>;
+
+/// Root of the trie without any entries, sha3(rlp("")).
+extern h256 const EmptyTrie;
+
+/// Root hash of the trie of the given key/value pairs.
+h256 trieRoot(BytesMap const& _data);
+
+/// Root hash of the trie with keys sha3(key), as used for state and storage tries.
+h256 secureTrieRoot(BytesMap const& _data);
+
+/// Root hash of the trie with keys rlp(index), as used for transactions, receipts and withdrawals.
+h256 orderedTrieRoot(std::vector<bytes> const& _data);
+
+/// Hex prefix encoding of the nibbles [_begin, _end) of a trie path. _end < 0 counts from the end.
+std::string hexPrefixEncode(bytes const& _nibbles, bool _leaf, int _begin = 0, int _end = -1);
+
+}
@@ -233,6 +233,9 @@ Options::Options(int argc, const char** argv)
     ADD_OPTION(exectimelog, "--exectimelog", [](){
         cout << setw(30) << "--exectimelog" << setw(25) << "Output execution time for each test suite\n";
     });
+    ADD_OPTION(exectimeprofile, "--exectimeprofile", [](){
+        cout << setw(30) << "--exectimeprofile <file>" << setw(25) << "Export per thread test phase timings to a Chrome trace file\n";
+    });
     ADD_OPTION(enableClientsOutput, "--stderr", [](){
         cout << setw(30) << "--stderr" << setw(25) << "Redirect ipc client stderr to stdout\n";
     });
@@ -296,6 +299,12 @@ Options::Options(int argc, const char** argv)
     ADD_OPTION(checkhash, "--checkhash", [](){
         cout << setw(30) << "--checkhash" << setw(25) << "Check that tests are updated from fillers\n";
     });
+    ADD_OPTION(hashindex, "--hashindex", [](){
+        cout << setw(30) << "--hashindex" << setw(25) << "Keep filler hashes of unchanged fillers in datadir for the next runs\n";
+    });
+    ADD_OPTION(rebuildhashindex, "--rebuildhashindex", [](){
+        cout << setw(30) << "--rebuildhashindex" << setw(25) << "Hash all fillers again and rewrite the filler hash index in datadir\n";
+    });
     ADD_OPTIONV(poststate, "--poststate", [](){
         cout << setw(30) << "--poststate" << setw(25) << "Debug(6) show test postState hash or fullstate, when used with --filltests export `postState` in StateTests\n";
         cout << setw(30) << "--poststate bl:tx" << setw(25) << "Show poststate of block number 'bl', transaction index 'tx' (from 0)\n";
@@ -313,6 +322,18 @@ Options::Options(int argc, const char** argv)
     ADD_OPTION(nopython, "--nopython", [](){
         cout << setw(30) << "--nopython" << setw(25) << "Do not generate .py tests\n";
     });
+    ADD_OPTION(genesisrootcache, "--genesisrootcache", [](){
+        cout << setw(30) << "--genesisrootcache" << setw(25) << "Keep genesis state roots in datadir for the next runs\n";
+    });
+    ADD_OPTION(notestcosts, "--notestcosts", [](){
+        cout << setw(30) << "--notestcosts" << setw(25) << "Do not read or save recorded test run times in datadir\n";
+    });
+    ADD_OPTION(compilecache, "--compilecache", [](){
+        cout << setw(30) << "--compilecache" << setw(25) << "Keep compiled code in datadir for the next runs\n";
+    });
+    ADD_OPTION(batchcompile, "--batchcompile", [](){
+        cout << setw(30) << "--batchcompile" << setw(25) << "Compile :yul and solidity codes of a test with one solc --standard-json call\n";
+    });
 
 
     // Sanity check
@@ -234,6 +234,7 @@ public:
     stringosizet_opt logVerbosity = 1;
     bool_opt nologcolor = false;
     bool_opt exectimelog = false;
+    string_opt exectimeprofile;
     bool_opt enableClientsOutput = false;
     bool_opt travisOutThread = false;
     string_opt t8ntoolcall;
@@ -252,10 +253,16 @@ public:
     sizet_opt chainid = 1;
     bool_opt showhash = false;
     bool_opt checkhash = false;
+    bool_opt hashindex = false;
+    bool_opt rebuildhashindex = false;
     booloutpathselector_opt poststate = false;
     bool_opt fullstate = false;
     bool_opt forceupdate = false;
     bool_opt nopython = false;
+    bool_opt genesisrootcache = false;
+    bool_opt notestcosts = false;
+    bool_opt compilecache = false;
+    bool_opt batchcompile = false;
     static bool isLegacy();
     static bool isLegacyConstantinople();
     static bool isEOFTest();
@@ -0,0 +1,84 @@
+#include "CompileCache.h"
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/SHA3.h>
+#include <retesteth/EthChecks.h>
+#include <retesteth/Options.h>
+#include <retesteth/helpers/PersistentCache.h>
+#include <boost/filesystem.hpp>
+
+using namespace std;
+using namespace test::debug;
+namespace fs = boost::filesystem;
+
+namespace test::compiler
+{
+CompileCache& CompileCache::get()
+{
+    static CompileCache instance(cacheDataDir() / "compilecache", Options::get().compilecache);
+    return instance;
+}
+
+CompileCache::CompileCache(fs::path const& _dir, bool _diskEnabled) : m_dir(_dir), m_diskEnabled(_diskEnabled) {}
+
+string CompileCache::makeKey(string const& _compiler, string const& _options, string const& _source)
+{
+    // Zero separators so that moving text between the parts changes the key
+    return dev::sha3(_compiler + '\0' + _options + '\0' + _source).hex();
+}
+
+fs::path CompileCache::entryPath(string const& _key) const
+{
+    return m_dir / _key.substr(0, 2) / _key;
+}
+
+bool CompileCache::find(string const& _key, string& _compiled)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto const compiled = m_compiled.find(_key);
+        if (compiled != m_compiled.end())
+        {
+            _compiled = compiled->second;
+            return true;
+        }
+    }
+
+    if (!m_diskEnabled)
+        return false;
+    boost::system::error_code ec;
+    fs::path const entry = entryPath(_key);
+    if (!fs::exists(entry, ec))
+        return false;
+    _compiled = dev::contentsString(entry);
+    if (_compiled.empty() || _compiled == "0x")
+        return false;
+    ETH_DC_MESSAGE(DC::LOWLOG, "Compiled code from cache: " + entry.string());
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_compiled[_key] = _compiled;
+    return true;
+}
+
+void CompileCache::store(string const& _key, string const& _compiled)
+{
+    if (_compiled.empty() || _compiled == "0x")
+        return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_compiled[_key] = _compiled;
+    }
+    if (!m_diskEnabled)
+        return;
+
+    try
+    {
+        // Workers storing the same key write the same code
+        writeFileAtomic(entryPath(_key), _compiled);
+    }
+    catch (std::exception const& _ex)
+    {
+        if (m_diskEnabled.exchange(false))
+            ETH_WARNING("Compile cache disabled, failed to write `" + m_dir.string() + "`: " + _ex.what());
+    }
+}
+
+}  // namespace test::compiler
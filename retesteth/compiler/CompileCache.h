@@ -0,0 +1,36 @@
+#pragma once
+#include <boost/filesystem/path.hpp>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace test::compiler
+{
+// Compiled code by hash of compiler, options and source, kept for the run
+// With --compilecache also kept in `<datadir>/compilecache` for the next runs
+// Entries are written to a unique temp file and renamed, so parallel workers never read a partial entry
+class CompileCache
+{
+public:
+    static CompileCache& get();
+    CompileCache(boost::filesystem::path const& _dir, bool _diskEnabled);
+
+    // _compiler identifies the compiler binary and its version
+    static std::string makeKey(std::string const& _compiler, std::string const& _options, std::string const& _source);
+
+    bool find(std::string const& _key, std::string& _compiled);
+
+    // Empty code is not stored, a compiler that failed without an error code must not be remembered
+    void store(std::string const& _key, std::string const& _compiled);
+
+private:
+    boost::filesystem::path entryPath(std::string const& _key) const;
+
+    std::mutex m_mutex;
+    std::map<std::string, std::string> m_compiled;
+    boost::filesystem::path m_dir;
+    std::atomic<bool> m_diskEnabled;
+};
+
+}  // namespace test::compiler
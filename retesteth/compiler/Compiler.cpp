@@ -1,10 +1,18 @@
+#include "CompileCache.h"
 #include "Options.h"
+#include <retesteth/configs/Options.h>
 #include <retesteth/helpers/TestHelper.h>
+#include <libdataobj/ConvertFile.h>
 #include <libdevcore/CommonIO.h>
 #include <retesteth/EthChecks.h>
 #include <retesteth/helpers/TestOutputHelper.h>
+#include <retesteth/helpers/TestProfiler.h>
+#include <boost/algorithm/string/trim.hpp>
+#include <set>
+#include <sstream>
 using namespace dev;
 using namespace test;
+using namespace test::debug;
 using namespace std;
 using namespace dataobject;
 using namespace test::compiler;
@@ -45,6 +53,11 @@ string compileLLL(string const& _code)
     BOOST_ERROR("LLL compilation only supported on posix systems.");
     return "";
 #else
+    string const cacheKey = CompileCache::makeKey("lllc " + prepareLLLCVersionString(), string(), _code);
+    string cached;
+    if (CompileCache::get().find(cacheKey, cached))
+        return cached;
+
     fs::path path(fs::temp_directory_path() / fs::unique_path());
     string cmd = string("lllc ") + path.string();
     writeFile(path.string(), _code);
@@ -55,6 +68,8 @@ string compileLLL(string const& _code)
         fs::remove_all(path);
         result = "0x" + result;
         test::compiler::utiles::checkHexHasEvenLength(result);
+        if (exitCode == 0)
+            CompileCache::get().store(cacheKey, result);
         return result;
     }
     catch (EthError const& _ex)
@@ -67,7 +82,16 @@ string compileLLL(string const& _code)
 }
 
 
-bool tryCustomCompiler(string const& _code, string& _compiledCode)
+// Custom compiler source of _code: compiler prefix and script, script arguments and the code to compile
+struct CustomCompilerSource
+{
+    string prefix;
+    fs::path script;
+    string arg;
+    string code;
+};
+
+bool findCustomCompiler(string const& _code, CustomCompilerSource& _source)
 {
     auto const& compilers = Options::getCurrentConfig().cfgFile().customCompilers();
     for (auto const& [compilerPrefix, compilerScript] : compilers)
@@ -92,13 +116,10 @@ bool tryCustomCompiler(string const& _code, string& _compiledCode)
                             arg += el + " ";
                     }
                 }
-                string const customCode = nativeArg + _code.substr(codeStartPos);
-                fs::path path(fs::temp_directory_path() / fs::unique_path());
-                string cmd = compilerScript.string() + " " + path.string() + " " + arg;
-                writeFile(path.string(), customCode);
-
-                int exitCode;
-                _compiledCode = test::executeCmd(cmd, exitCode);
+                _source.prefix = compilerPrefix;
+                _source.script = compilerScript;
+                _source.arg = arg;
+                _source.code = nativeArg + _code.substr(codeStartPos);
                 return true;
             }
         }
@@ -106,6 +127,43 @@ bool tryCustomCompiler(string const& _code, string& _compiledCode)
     return false;
 }
 
+// The script calls the compiler, so its content and the version of solc it runs are the compiler identity
+string customCompilerCacheKey(CustomCompilerSource const& _source)
+{
+    string const script = dev::contentsString(_source.script);
+    string compilerId = _source.script.string() + "\n" + script;
+    if (script.find("solc") != string::npos)
+        compilerId += "\n" + prepareSolidityVersionString();
+    return CompileCache::makeKey(compilerId, _source.arg, _source.code);
+}
+
+bool tryCustomCompiler(string const& _code, string& _compiledCode)
+{
+    CustomCompilerSource source;
+    if (!findCustomCompiler(_code, source))
+        return false;
+
+    string const cacheKey = customCompilerCacheKey(source);
+    if (CompileCache::get().find(cacheKey, _compiledCode))
+        return true;
+
+    fs::path path(fs::temp_directory_path() / fs::unique_path());
+    string cmd = source.script.string() + " " + path.string() + " " + source.arg;
+    writeFile(path.string(), source.code);
+
+    int exitCode;
+    _compiledCode = test::executeCmd(cmd, exitCode);
+    if (exitCode == 0)
+        CompileCache::get().store(cacheKey, _compiledCode);
+    return true;
+}
+
+// Other `:yul` scripts may call the compiler with other settings
+bool isRetestethYulCompiler(CustomCompilerSource const& _source)
+{
+    return _source.prefix == ":yul" && dev::contentsString(_source.script) == retesteth::options::yul_compiler_sh;
+}
+
 void tryKnownCompilers(string const& _code, solContracts const& _preSolidity, string& _compiledCode)
 {
     string const c_rawPrefix = ":raw";
@@ -185,6 +243,96 @@ void checkHexHasEvenLength(string const& _hex)
     ETH_ERROR_REQUIRE_MESSAGE(_hex.length() % 2 == 0,
         TestOutputHelper::get().testName() + ": Hex field is expected to be of odd length: '" + _hex + "'");
 }
+
+spDataObject makeStandardJsonInput(StandardJsonBatch const& _batch)
+{
+    spDataObject input;
+    (*input)["language"] = _batch.language;
+    for (size_t i = 0; i < _batch.sources.size(); i++)
+        (*input)["sources"]["s" + test::fto_string(i)]["content"] = _batch.sources.at(i);
+
+    DataObject& settings = (*input)["settings"];
+    if (!_batch.evmVersion.empty())
+        settings["evmVersion"] = _batch.evmVersion;
+    settings["optimizer"]["enabled"] = _batch.optimize;
+    if (_batch.optimize)
+    {
+        // yul.sh runs solc --optimize --yul-optimizations=":"
+        settings["optimizer"]["details"]["yul"] = true;
+        settings["optimizer"]["details"]["yulDetails"]["optimizerSteps"] = ":";
+    }
+
+    // yul.sh takes the binary of the object, compileSolidity takes the runtime binary
+    string const output = _batch.language == "Yul" ? "evm.bytecode.object" : "evm.deployedBytecode.object";
+    settings["outputSelection"]["*"]["*"].addArrayObject(spDataObject(new DataObject(output)));
+    return input;
+}
+
+void compileStandardJsonBatch(StandardJsonBatch const& _batch)
+{
+    fs::path const path(fs::temp_directory_path() / fs::unique_path());
+    writeFile(path.string(), makeStandardJsonInput(_batch)->asJson(0, false));
+    string const cmd = "solc --standard-json " + path.string();
+    ETH_DC_MESSAGE(DC::LOWLOG, cmd + " (" + test::fto_string(_batch.sources.size()) + " " + _batch.language + " sources)");
+    int exitCode;
+    string const response = executeCmd(cmd, exitCode, ExecCMDWarning::NoWarningNoError);
+    fs::remove_all(path);
+
+    // Anything unexpected leaves the codes to be compiled one by one
+    spDataObject output;
+    try
+    {
+        output = dataobject::ConvertJsoncppStringToData(response);
+    }
+    catch (std::exception const&)
+    {
+        ETH_DC_MESSAGE(DC::LOWLOG, "solc --standard-json returned invalid json: " + response.substr(0, 200));
+        return;
+    }
+    if (exitCode != 0 || !output->count("contracts"))
+        return;
+
+    // Sources with errors are compiled one by one to report the errors as usual
+    std::set<string> failedSources;
+    if (output->count("errors"))
+    {
+        for (auto const& error : output->atKey("errors").getSubObjects())
+        {
+            if (!error->count("severity") || error->atKey("severity").asString() != "error")
+                continue;
+            if (!error->count("sourceLocation"))
+                return;
+            failedSources.emplace(error->atKey("sourceLocation").atKey("file").asString());
+        }
+    }
+
+    string const bytecodeKey = _batch.language == "Yul" ? "bytecode" : "deployedBytecode";
+    DataObject const& contracts = output->atKey("contracts");
+    for (size_t i = 0; i < _batch.sources.size(); i++)
+    {
+        string const sourceName = "s" + test::fto_string(i);
+        if (failedSources.count(sourceName) || !contracts.count(sourceName))
+            continue;
+
+        // Only one contract is allowed per code, let the usual compilation fail on others
+        auto const& sourceContracts = contracts.atKey(sourceName).getSubObjects();
+        if (sourceContracts.size() != 1)
+            continue;
+        DataObject const& contract = sourceContracts.at(0).getCContent();
+        if (!contract.count("evm") || !contract.atKey("evm").count(bytecodeKey))
+            continue;
+        string const code = "0x" + contract.atKey("evm").atKey(bytecodeKey).atKey("object").asString();
+        if (_batch.language == "Yul")
+            CompileCache::get().store(_batch.cacheKeys.at(i), code);
+        else
+        {
+            // As cached by compileSolidity
+            DataObject compiled(DataType::Object);
+            compiled[contract.getKey()] = code;
+            CompileCache::get().store(_batch.cacheKeys.at(i), compiled.asJson(0, false));
+        }
+    }
+}
 }  // namespace utiles
 
 /// This function is called for every account "code" : field in Fillers
@@ -203,6 +351,7 @@ string replaceCode(string const& _code, solContracts const& _preSolidity)
         return _code;
     }
 
+    ProfileScope profile(ProfilePhase::CompileCode);
     string compiledCode;
     bool customCompilerWorked = tryCustomCompiler(_code, compiledCode);
     if (!customCompilerWorked)
@@ -220,6 +369,63 @@ string replaceCode(string const& _code, solContracts const& _preSolidity)
 }
 
 
+void precompileCodes(vector<string> const& _codes)
+{
+    if (!Options::get().batchcompile || !test::checkCmdExist("solc"))
+        return;
+
+    std::map<string, utiles::StandardJsonBatch> batches;
+    std::set<string> cacheKeys;
+    for (auto const& code : _codes)
+    {
+        utiles::StandardJsonBatch settings;
+        string source;
+        string cacheKey;
+        CustomCompilerSource custom;
+        if (findCustomCompiler(code, custom))
+        {
+            if (!isRetestethYulCompiler(custom))
+                continue;
+
+            // yul.sh arguments: evm version, a second argument disables the optimizer
+            vector<string> args;
+            std::istringstream argStream(custom.arg);
+            for (string arg; argStream >> arg;)
+                args.emplace_back(arg);
+            settings.language = "Yul";
+            settings.evmVersion = args.empty() ? string() : args.at(0);
+            settings.optimize = args.size() < 2;
+            source = custom.code;
+            cacheKey = customCompilerCacheKey(custom);
+        }
+        else if (code.find("pragma solidity") != string::npos)
+        {
+            string const evmVersionArg = utiles::solcEvmVersionArg(code);
+            settings.language = "Solidity";
+            string const c_evmVersionOption = "--evm-version ";
+            if (!evmVersionArg.empty())
+                settings.evmVersion = boost::trim_copy(evmVersionArg.substr(c_evmVersionOption.size()));
+            source = code;
+            cacheKey = utiles::solidityCacheKey(code);
+        }
+        else
+            continue;
+
+        string cached;
+        if (!cacheKeys.emplace(cacheKey).second || CompileCache::get().find(cacheKey, cached))
+            continue;
+        string const batchKey = settings.language + " " + settings.evmVersion + (settings.optimize ? " optimize" : "");
+        utiles::StandardJsonBatch& batch = batches.emplace(batchKey, settings).first->second;
+        batch.sources.emplace_back(source);
+        batch.cacheKeys.emplace_back(cacheKey);
+    }
+
+    // A single code is compiled as usual
+    for (auto const& batch : batches)
+        if (batch.second.sources.size() > 1)
+            utiles::compileStandardJsonBatch(batch.second);
+}
+
 std::string compilePyopcode(std::string const& _code)
 {
     if (_code == "")
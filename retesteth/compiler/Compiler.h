@@ -1,6 +1,7 @@
 #pragma once
 #include <libdataobj/DataObject.h>
 #include <string>
+#include <vector>
 
 namespace test::compiler
 {
@@ -12,6 +13,29 @@ void checkHexHasEvenLength(std::string const& _hex);
 /// ecnode abi options into bytecode
 std::string encodeAbi(std::string const& _code);
 
+/// `--evm-version` solc argument from RETESTETH_SOLC_EVM_VERSION= comment in solidity source
+std::string solcEvmVersionArg(std::string const& _code);
+
+/// compile cache key of solidity source compiled by compileSolidity
+std::string solidityCacheKey(std::string const& _code);
+
+/// sources of one `solc --standard-json` call, they share the compiler settings
+struct StandardJsonBatch
+{
+    std::string language;
+    std::string evmVersion;
+    bool optimize = false;
+    std::vector<std::string> sources;
+    std::vector<std::string> cacheKeys;
+};
+
+/// `solc --standard-json` input of the batch, the settings match those of yul.sh and compileSolidity
+dataobject::spDataObject makeStandardJsonInput(StandardJsonBatch const& _batch);
+
+/// compile the batch with one solc call and store the codes under the cache keys of the sources
+/// sources that fail are left to be compiled one by one
+void compileStandardJsonBatch(StandardJsonBatch const& _batch);
+
 }  // namespace utiles
 
 
@@ -42,4 +66,8 @@ std::string compileYul(std::string const& _code);
 
 std::string compilePyopcode(std::string const& _code);
 
+/// compile `:yul` and inline solidity codes of a test with one `solc --standard-json` call per settings
+/// results are put into the compile cache where replaceCode finds them. Enabled with --batchcompile
+void precompileCodes(std::vector<std::string> const& _codes);
+
 }  // namespace compiler
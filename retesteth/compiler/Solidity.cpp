@@ -1,4 +1,6 @@
+#include "CompileCache.h"
 #include <retesteth/helpers/TestHelper.h>
+#include <libdataobj/ConvertFile.h>
 #include <libdevcore/CommonIO.h>
 #include <libdevcore/SHA3.h>
 #include <retesteth/EthChecks.h>
@@ -426,24 +428,55 @@ namespace test
 {
 namespace compiler
 {
+namespace utiles
+{
+string solcEvmVersionArg(string const& _code)
+{
+    string const versionComment = "RETESTETH_SOLC_EVM_VERSION=";
+    size_t const pos = _code.find(versionComment);
+    if (pos != string::npos)
+    {
+        size_t const endl = _code.find('\n', pos + versionComment.size());
+        if (endl != string::npos)
+            return "--evm-version " + _code.substr(pos + versionComment.size(), endl - pos - versionComment.size());
+    }
+    return string();
+}
+
+string solidityCacheKey(string const& _code)
+{
+    return CompileCache::makeKey("solc " + prepareSolidityVersionString(), solcEvmVersionArg(_code), _code);
+}
+}  // namespace utiles
+
 solContracts compileSolidity(string const& _code)
 {
 #if defined(_WIN32)
     BOOST_ERROR("Solidity compilation only supported on posix systems.");
     return "";
 #else
-    string evmVersion;
-    string const versionComment = "RETESTETH_SOLC_EVM_VERSION=";
-    size_t pos = _code.find(versionComment);
-    if (pos != string::npos)
+    string const evmVersion = utiles::solcEvmVersionArg(_code);
+
+    // Cached as json {"contractName" : "bytecode"}
+    string const cacheKey = utiles::solidityCacheKey(_code);
+    string cached;
+    if (CompileCache::get().find(cacheKey, cached))
     {
-        size_t const endl = _code.find('\n', pos + versionComment.size());
-        if (endl != string::npos)
+        try
+        {
+            solContracts contracts;
+            spDataObject const data = dataobject::ConvertJsoncppStringToData(cached);
+            for (auto const& contract : data->getSubObjects())
+                contracts.insertCode(contract->getKey(), contract->asString());
+            if (contracts.Contracts().size())
+                return contracts;
+        }
+        catch (std::exception const&)
         {
-            evmVersion = "--evm-version ";
-            evmVersion += _code.substr(pos + versionComment.size(), endl - pos - versionComment.size());
+            ETH_DC_MESSAGE(DC::LOWLOG, "Broken solc compile cache entry, recompiling");
         }
     }
+
     fs::path const path(fs::temp_directory_path() / fs::unique_path());
     string const cmd = string("solc " + evmVersion + " --bin-runtime ") + path.string();
     writeFile(path.string(), _code);
@@ -454,7 +487,7 @@ solContracts compileSolidity(string const& _code)
     string const codeNamePrefix = "=======";
     string const codeBytePrefix = "Binary of the runtime part:";
 
-    pos = result.find(codeNamePrefix);
+    size_t pos = result.find(codeNamePrefix);
     while (pos != string::npos)
     {
         // Contract name ======= /tmp/ad01-b64d-321b-c636:TokenCreator =======
@@ -492,6 +525,11 @@ solContracts compileSolidity(string const& _code)
     if (contracts.Contracts().size() == 0)
         ETH_ERROR_MESSAGE("Compiling solc: bytecode prefix `" + codeNamePrefix + "` not found in the result output!");
     fs::remove_all(path);
+
+    DataObject compiled(DataType::Object);
+    for (auto const& contract : contracts.Contracts())
+        compiled[contract->getKey()] = contract->asString();
+    CompileCache::get().store(cacheKey, compiled.asJson(0, false));
     return contracts;
 #endif
 }
@@ -61,6 +61,9 @@ else
         fi
         cmdArgs=$cmdArgs" "$index
     done
+    if [ -z "$errorLogFile" ]; then
+        errorLogFile=/dev/stderr
+    fi
     if [ $stateProvided -eq 1 ]; then
         evm --verbosity 2 t8n $cmdArgs 2> $errorLogFile
     else
@@ -72,6 +75,43 @@ fi
 gent8ntoolcfg::gent8ntoolcfg()
 {
 
+// Reference t8nDaemon adapter for geth's evm. Reads request lines from stdin, replies with response lines
+// A client implementing the same protocol in process avoids the process start per block entirely
+// Supports t8nDaemonAllocDiff by remembering recent post states by their stateRoot
+string const t8ntool_daemon = R"(#!/usr/bin/env python3
+import json, subprocess, sys
+
+states = {}
+for line in sys.stdin:
+    if not line.strip():
+        continue
+    req = json.loads(line)
+    inp = req["input"]
+    if "allocRef" in inp:
+        if inp["allocRef"] not in states:
+            sys.stdout.write(json.dumps({"exitCode": 1, "unknownAllocRef": True}) + "\n")
+            sys.stdout.flush()
+            continue
+        inp["alloc"] = states[inp.pop("allocRef")]
+    proc = subprocess.run(["evm", "--verbosity", "2", "t8n"] + req["args"],
+        input=json.dumps(inp), capture_output=True, text=True)
+    res = {"exitCode": proc.returncode, "error": proc.stderr}
+    if proc.returncode == 0:
+        out = json.loads(proc.stdout)
+        post = {k.lower(): v for k, v in out["alloc"].items()}
+        states[out["result"]["stateRoot"]] = post
+        while len(states) > 64:
+            states.pop(next(iter(states)))
+        if req.get("outputAllocDiff"):
+            pre = {k.lower(): v for k, v in inp["alloc"].items()}
+            diff = {k: v for k, v in post.items() if pre.get(k) != v}
+            diff.update({k: None for k in pre if k not in post})
+            out["allocDiff"] = diff
+            del out["alloc"]
+        res["output"] = out
+    sys.stdout.write(json.dumps(res) + "\n")
+    sys.stdout.flush()
+)";
 string const t8ntool_config = R"({
     "name" : "Ethereum GO on StateTool",
     "socketType" : "tranition-tool",
@@ -85,6 +125,7 @@ string const t8ntool_config = R"({
     "support1559" : true,
     "supportBigint" : true,
     "transactionsAsJson" : false,
+    "t8nStdio" : false,
     "tmpDir" : "/dev/shm",
     "defaultChainID" : 1,
     "customCompilers" : {
@@ -624,6 +665,13 @@ echo $(evm_bytes_to_python $2)
         (*obj)["content"] = t8ntool_start;
         map_configs.addArrayObject(obj);
     }
+    {
+        spDataObject obj;
+        (*obj)["exec"] = true;
+        (*obj)["path"] = "t8ntool/t8ndaemon.py";
+        (*obj)["content"] = t8ntool_daemon;
+        map_configs.addArrayObject(obj);
+    }
     {
         spDataObject obj;
         (*obj)["exec"] = true;
@@ -0,0 +1,131 @@
+#include "FillerHashIndex.h"
+#include <retesteth/EthChecks.h>
+#include <retesteth/Options.h>
+#include <retesteth/helpers/TestHelper.h>
+#include <boost/filesystem.hpp>
+#include <ctime>
+#include <sys/stat.h>
+
+using namespace std;
+using namespace dataobject;
+using namespace test::debug;
+namespace fs = boost::filesystem;
+
+namespace
+{
+// A filler changed within the same second as its mtime could still have the old mtime after the change
+int64_t const c_racyMtimeSeconds = 2;
+}  // namespace
+
+namespace test
+{
+FillerHashIndex& FillerHashIndex::get()
+{
+    auto const& opt = Options::get();
+    static FillerHashIndex instance(
+        cacheDataDir() / "fillerhashes.json", opt.hashindex || opt.rebuildhashindex, opt.rebuildhashindex);
+    return instance;
+}
+
+FillerHashIndex::FillerHashIndex(fs::path const& _file, bool _enabled, bool _rebuild)
+  : m_file(_file, "filler hash index", prepareVersionString()), m_enabled(_enabled), m_rebuild(_rebuild)
+{
+    // The hash algorithm may change with retesteth, the index of another version is not read
+    if (!m_enabled || m_rebuild)
+        return;
+    spDataObject const index = m_file.load();
+    for (auto const& el : index->getSubObjects())
+    {
+        try
+        {
+            Entry entry;
+            entry.size = (size_t)el->atKey("size").asInt();
+            entry.mtime = (int64_t)std::stoll(el->atKey("mtime").asString());
+            entry.inode = (uint64_t)std::stoull(el->atKey("inode").asString());
+            entry.hash = dev::h256(el->atKey("hash").asString());
+            m_entries[el->getKey()] = entry;
+        }
+        catch (std::exception const&)
+        {
+            // A broken entry is hashed again
+        }
+    }
+}
+
+string FillerHashIndex::makeKey(fs::path const& _filler)
+{
+    // Legacy fillers are sorted on load, that gives another hash
+    fs::path const path = fs::absolute(_filler).lexically_normal();
+    return (Options::isLegacyConstantinople() ? "legacy:" : "") + path.string();
+}
+
+bool FillerHashIndex::readFileStat(fs::path const& _filler, Entry& _entry)
+{
+#if defined(_WIN32)
+    return false;
+#else
+    struct stat st;
+    if (::stat(_filler.c_str(), &st) != 0)
+        return false;
+    _entry.size = (size_t)st.st_size;
+    _entry.mtime = (int64_t)st.st_mtime;
+    _entry.inode = (uint64_t)st.st_ino;
+    return true;
+#endif
+}
+
+bool FillerHashIndex::find(fs::path const& _filler, dev::h256& _hash)
+{
+    Entry current;
+    if (!m_enabled || !readFileStat(_filler, current))
+        return false;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto const entry = m_entries.find(makeKey(_filler));
+    if (entry == m_entries.end())
+        return false;
+    Entry const& indexed = entry->second;
+    if (indexed.size != current.size || indexed.mtime != current.mtime || indexed.inode != current.inode)
+        return false;
+    _hash = indexed.hash;
+    ETH_DC_MESSAGE(DC::TESTLOG, "Filler hash from index: " + _filler.string());
+    return true;
+}
+
+void FillerHashIndex::record(fs::path const& _filler, dev::h256 const& _hash)
+{
+    Entry entry;
+    if (!m_enabled || !readFileStat(_filler, entry) || (int64_t)std::time(nullptr) - entry.mtime < c_racyMtimeSeconds)
+        return;
+    entry.hash = _hash;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    string const key = makeKey(_filler);
+    m_entries[key] = entry;
+    m_recorded.emplace(key);
+}
+
+void FillerHashIndex::save()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_enabled || (m_recorded.empty() && !m_rebuild))
+        return;
+
+    DataObject fillers(DataType::Object);
+    for (auto const& key : m_recorded)
+    {
+        Entry const& entry = m_entries.at(key);
+        DataObject& record = fillers[key];
+        record["size"] = (int)entry.size;
+        record["mtime"] = test::fto_string(entry.mtime);
+        record["inode"] = test::fto_string(entry.inode);
+        record["hash"] = "0x" + entry.hash.hex();
+    }
+    if (m_file.save(fillers, m_rebuild))
+    {
+        m_recorded.clear();
+        m_rebuild = false;
+    }
+}
+
+}  // namespace test
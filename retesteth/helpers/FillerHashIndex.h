@@ -0,0 +1,48 @@
+#pragma once
+#include <libdevcore/FixedHash.h>
+#include <retesteth/helpers/PersistentCache.h>
+#include <boost/filesystem/path.hpp>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace test
+{
+// Source hashes of test fillers by path, size, mtime and inode, stored in `<datadir>/fillerhashes.json`
+// An unchanged filler gets its hash from here instead of being parsed and hashed again
+// Used with --hashindex, rebuilt from scratch with --rebuildhashindex. The hashes decide --checkhash verdicts,
+// so a filler copied with its mtime kept could be trusted wrongly and the index is not used by default
+class FillerHashIndex
+{
+public:
+    static FillerHashIndex& get();
+    FillerHashIndex(boost::filesystem::path const& _file, bool _enabled, bool _rebuild);
+
+    bool find(boost::filesystem::path const& _filler, dev::h256& _hash);
+    void record(boost::filesystem::path const& _filler, dev::h256 const& _hash);
+
+    // Merge with the index saved by other retesteth instances meanwhile
+    void save();
+
+private:
+    struct Entry
+    {
+        size_t size = 0;
+        int64_t mtime = 0;
+        uint64_t inode = 0;
+        dev::h256 hash;
+    };
+
+    static std::string makeKey(boost::filesystem::path const& _filler);
+    static bool readFileStat(boost::filesystem::path const& _filler, Entry& _entry);
+
+    std::mutex m_mutex;
+    std::map<std::string, Entry> m_entries;
+    std::set<std::string> m_recorded;
+    PersistentCacheFile m_file;
+    bool m_enabled;
+    bool m_rebuild;
+};
+
+}  // namespace test
@@ -0,0 +1,130 @@
+#include "PersistentCache.h"
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/FileSystem.h>
+#include <retesteth/EthChecks.h>
+#include <retesteth/Options.h>
+#include <retesteth/helpers/TestHelper.h>
+#include <boost/filesystem.hpp>
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace dataobject;
+namespace fs = boost::filesystem;
+
+namespace
+{
+// Exclusive lock of `<file>.lock` for the time of the merge, released when the instance is gone
+class CacheFileLock
+{
+public:
+    CacheFileLock(fs::path const& _file)
+    {
+#if !defined(_WIN32)
+        m_fd = ::open((_file.string() + ".lock").c_str(), O_CREAT | O_RDWR | O_CLOEXEC, 0644);
+        if (m_fd >= 0 && ::flock(m_fd, LOCK_EX) != 0)
+        {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+#else
+        (void)_file;
+#endif
+    }
+    ~CacheFileLock()
+    {
+#if !defined(_WIN32)
+        if (m_fd >= 0)
+            ::close(m_fd);
+#endif
+    }
+
+private:
+    int m_fd = -1;
+};
+}  // namespace
+
+namespace test
+{
+fs::path cacheDataDir()
+{
+    fs::path const dataDir = Options::get().datadir;
+    return dataDir.empty() ? dev::getDataDir("retesteth") : dataDir;
+}
+
+void writeFileAtomic(fs::path const& _file, string const& _content)
+{
+    fs::path const tmp = _file.parent_path() / fs::unique_path(_file.filename().string() + "-%%%%-%%%%-%%%%.tmp");
+    try
+    {
+        fs::create_directories(_file.parent_path());
+        dev::writeFile(tmp, _content);
+        fs::rename(tmp, _file);
+    }
+    catch (...)
+    {
+        boost::system::error_code ec;
+        fs::remove(tmp, ec);
+        throw;
+    }
+}
+
+PersistentCacheFile::PersistentCacheFile(fs::path const& _file, string const& _description, string const& _version)
+  : m_file(_file), m_description(_description), m_version(_version)
+{}
+
+spDataObject PersistentCacheFile::readEntries(bool _warn) const
+{
+    boost::system::error_code ec;
+    if (!fs::exists(m_file, ec))
+        return sDataObject(DataType::Object);
+    try
+    {
+        spDataObject data = readJsonData(m_file);
+        if (!data->count("version") || data->atKey("version").asString() != m_version || !data->count("entries") ||
+            data->atKey("entries").type() != DataType::Object)
+            return sDataObject(DataType::Object);
+        return (*data).atKeyPointer("entries");
+    }
+    catch (std::exception const& _ex)
+    {
+        if (_warn)
+            ETH_WARNING("Ignoring broken " + m_description + " `" + m_file.string() + "`: " + _ex.what());
+        return sDataObject(DataType::Object);
+    }
+}
+
+spDataObject PersistentCacheFile::load() const
+{
+    return readEntries(true);
+}
+
+bool PersistentCacheFile::save(DataObject const& _entries, bool _rebuild) const
+{
+    try
+    {
+        fs::create_directories(m_file.parent_path());
+        CacheFileLock const lock(m_file);
+
+        // Entries saved by other instances meanwhile are kept, the given entries win
+        spDataObject entries = _rebuild ? sDataObject(DataType::Object) : readEntries(false);
+        for (auto const& el : _entries.getSubObjects())
+            (*entries).atKeyPointer(el->getKey()) = el;
+
+        DataObject file(DataType::Object);
+        file["version"] = m_version;
+        file.atKeyPointer("entries") = entries;
+        writeFileAtomic(m_file, file.asJson());
+        return true;
+    }
+    catch (std::exception const& _ex)
+    {
+        ETH_WARNING("Failed to save " + m_description + " `" + m_file.string() + "`: " + _ex.what());
+        return false;
+    }
+}
+
+}  // namespace test
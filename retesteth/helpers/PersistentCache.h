@@ -0,0 +1,39 @@
+#pragma once
+#include <libdataobj/DataObject.h>
+#include <boost/filesystem/path.hpp>
+#include <string>
+
+namespace test
+{
+// Directory of the caches kept between runs, --datadir or `~/.retesteth`
+boost::filesystem::path cacheDataDir();
+
+// Replace _file with _content at once by renaming a unique temp file over it
+// Readers see either the old or the new file. Throws on failure
+void writeFileAtomic(boost::filesystem::path const& _file, std::string const& _content);
+
+// Json file of cache entries shared by concurrent retesteth instances
+// A missing or broken file, or a file of another version, is read as no entries
+// Saving merges the entries with the file under an exclusive lock, so no instance loses the entries of the other
+class PersistentCacheFile
+{
+public:
+    PersistentCacheFile(boost::filesystem::path const& _file, std::string const& _description,
+        std::string const& _version = std::string());
+
+    dataobject::spDataObject load() const;
+
+    // _entries replace the same keys of the file, with _rebuild the entries of the file are dropped
+    bool save(dataobject::DataObject const& _entries, bool _rebuild = false) const;
+
+    boost::filesystem::path const& path() const { return m_file; }
+
+private:
+    dataobject::spDataObject readEntries(bool _warn) const;
+
+    boost::filesystem::path m_file;
+    std::string m_description;
+    std::string m_version;
+};
+
+}  // namespace test
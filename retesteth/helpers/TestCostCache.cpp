@@ -0,0 +1,107 @@
+#include "TestCostCache.h"
+#include <retesteth/Options.h>
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <tuple>
+
+using namespace std;
+using namespace dataobject;
+namespace fs = boost::filesystem;
+
+namespace
+{
+// Guess for fillers without history, refined by the folder's recorded tests
+double const c_defaultMsPerByte = 0.01;
+}  // namespace
+
+namespace test
+{
+TestCostCache& TestCostCache::get()
+{
+    static TestCostCache instance;
+    return instance;
+}
+
+TestCostCache::TestCostCache()
+  : m_file(cacheDataDir() / "testcosts.json", "test cost cache", "2"), m_enabled(!Options::get().notestcosts)
+{
+    if (!m_enabled)
+        return;
+    spDataObject const costs = m_file.load();
+    for (auto const& el : costs->getSubObjects())
+    {
+        if (el->type() == DataType::Integer)
+            m_costMs[el->getKey()] = el->asInt();
+    }
+}
+
+string TestCostCache::makeKey(fs::path const& _filler)
+{
+    // Client config / suite filler folder / test folder / filler, the same on any machine
+    // Clients run the same test at very different speed, so the times are kept per config
+    fs::path const folder = _filler.parent_path();
+    string const& config = Options::getDynamicOptions().getCurrentConfig().cfgFile().name();
+    return (fs::path(config) / folder.parent_path().filename() / folder.filename() / _filler.filename()).string();
+}
+
+void TestCostCache::orderLongestFirst(vector<fs::path>& _fillers)
+{
+    // cost in ms (-1 if unknown), filler size, filler index
+    vector<tuple<double, size_t, size_t>> costs;
+    costs.reserve(_fillers.size());
+    double knownMs = 0;
+    double knownBytes = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (size_t i = 0; i < _fillers.size(); i++)
+        {
+            boost::system::error_code ec;
+            size_t const size = fs::file_size(_fillers.at(i), ec);
+            auto const cost = m_costMs.find(makeKey(_fillers.at(i)));
+            double const ms = cost == m_costMs.end() ? -1 : cost->second;
+            costs.emplace_back(ms, ec ? 0 : size, i);
+            if (ms >= 0)
+            {
+                knownMs += ms;
+                knownBytes += std::get<1>(costs.back());
+            }
+        }
+    }
+
+    double const msPerByte = knownBytes > 0 ? knownMs / knownBytes : c_defaultMsPerByte;
+    for (auto& cost : costs)
+        if (std::get<0>(cost) < 0)
+            std::get<0>(cost) = std::get<1>(cost) * msPerByte;
+
+    // Equal costs keep the directory order
+    std::stable_sort(costs.begin(), costs.end(),
+        [](auto const& _a, auto const& _b) { return std::get<0>(_a) > std::get<0>(_b); });
+    vector<fs::path> ordered;
+    ordered.reserve(_fillers.size());
+    for (auto const& cost : costs)
+        ordered.emplace_back(std::move(_fillers.at(std::get<2>(cost))));
+    _fillers = std::move(ordered);
+}
+
+void TestCostCache::record(fs::path const& _filler, double _seconds)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    string const key = makeKey(_filler);
+    m_costMs[key] = (size_t)(_seconds * 1000);
+    m_recorded.emplace(key);
+}
+
+void TestCostCache::save()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_enabled || m_recorded.empty())
+        return;
+
+    DataObject costs(DataType::Object);
+    for (auto const& key : m_recorded)
+        costs[key] = (int)m_costMs.at(key);
+    if (m_file.save(costs))
+        m_recorded.clear();
+}
+
+}  // namespace test
@@ -0,0 +1,37 @@
+#pragma once
+#include <retesteth/helpers/PersistentCache.h>
+#include <boost/filesystem/path.hpp>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace test
+{
+// Wall time of test fillers recorded on previous runs per client config, stored in `<datadir>/testcosts.json`
+// Used to start the longest tests first, so one long test does not keep the run going when other workers are idle
+// Not read or saved with --notestcosts
+class TestCostCache
+{
+public:
+    static TestCostCache& get();
+
+    // Sort _fillers by expected time, longest first
+    // Fillers never run before are estimated by their file size
+    void orderLongestFirst(std::vector<boost::filesystem::path>& _fillers);
+    void record(boost::filesystem::path const& _filler, double _seconds);
+    void save();
+
+private:
+    TestCostCache();
+    static std::string makeKey(boost::filesystem::path const& _filler);
+
+    std::mutex m_mutex;
+    std::map<std::string, size_t> m_costMs;
+    std::set<std::string> m_recorded;
+    PersistentCacheFile m_file;
+    bool m_enabled = true;
+};
+
+}  // namespace test
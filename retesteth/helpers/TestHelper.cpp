@@ -1,5 +1,10 @@
 #include <BuildInfo.h>
 #include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/uuid/uuid_generators.hpp>  // generators
 #include <boost/uuid/uuid_io.hpp>
@@ -453,60 +458,171 @@ void strToLower(string& _input)
     std::transform(_input.begin(), _input.end(), _input.begin(), [](unsigned char c) { return std::tolower(c); });
 }
 
-bool checkCmdExist(std::string const& _command)
+namespace
 {
-    string cmd;
-    const size_t pos = _command.find_first_of(" ");
-    if (pos != string::npos)
-        cmd = _command.substr(0, pos);
-    else
-        cmd = _command;
+// Characters that need /bin/sh to interpret the command line
+string const c_shellChars = "|&;<>()$`\\\"'*?[]{}#~!\t\n";
 
-    const string checkCmd = string("which " + cmd + " > /dev/null 2>&1");
-    const bool checkBoost = fs::exists(cmd);
-    if (!checkBoost && system(checkCmd.c_str()))
-        return false;
-    return true;
+// Executables found in PATH, looked up once per command name
+std::mutex g_cmdPathsMutex;
+std::map<string, string> g_cmdPaths;
+
+// access(X_OK) accepts directories as well
+bool isRegularFile(string const& _path)
+{
+    boost::system::error_code ec;
+    return fs::is_regular_file(_path, ec);
+}
+
+string findCmdPath(string const& _cmd)
+{
+    if (_cmd.find('/') != string::npos)
+        return access(_cmd.c_str(), X_OK) == 0 && isRegularFile(_cmd) ? _cmd : string();
+
+    char const* envPath = getenv("PATH");
+    for (auto const& dir : explode(envPath ? envPath : "/usr/bin:/bin", ':'))
+    {
+        string const path = (dir.empty() ? string(".") : dir) + "/" + _cmd;
+        if (access(path.c_str(), X_OK) == 0 && isRegularFile(path))
+            return path;
+    }
+    return string();
+}
+
+// Program and arguments of the command, run through /bin/sh only if it uses shell syntax
+struct SpawnCommand
+{
+    string path;
+    vector<string> argv;
+};
+
+SpawnCommand makeSpawnCommand(string const& _command)
+{
+    SpawnCommand cmd;
+    if (_command.find_first_of(c_shellChars) == string::npos)
+    {
+        for (auto const& arg : explode(_command, ' '))
+            if (!arg.empty())
+                cmd.argv.emplace_back(arg);
+        if (!cmd.argv.empty() && cmd.argv.at(0).find('=') == string::npos)
+        {
+            cmd.path = resolveCmdPath(cmd.argv.at(0));
+            if (!cmd.path.empty())
+                return cmd;
+        }
+    }
+    cmd.path = "/bin/sh";
+    cmd.argv = {"sh", "-c", _command};
+    return cmd;
+}
+
+// Start the program with the given descriptors (-1 to inherit ours) as its stdin, stdout and stderr
+// Returns 0 or the error number
+int spawnProgram(SpawnCommand const& _cmd, int _stdin, int _stdout, int _stderr, pid_t& _pid)
+{
+    vector<char*> argv;
+    for (auto const& arg : _cmd.argv)
+        argv.emplace_back(const_cast<char*>(arg.c_str()));
+    argv.emplace_back(nullptr);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    int const fds[3] = {_stdin, _stdout, _stderr};
+    for (int i = 0; i < 3; i++)
+        if (fds[i] != -1)
+            posix_spawn_file_actions_adddup2(&actions, fds[i], i);
+
+    // Do not pass the signal mask of the calling thread to the tool
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+    sigset_t noSignals;
+    sigemptyset(&noSignals);
+    posix_spawnattr_setsigmask(&attr, &noSignals);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK);
+
+    int const res = posix_spawn(&_pid, _cmd.path.c_str(), &actions, &attr, argv.data(), environ);
+    posix_spawnattr_destroy(&attr);
+    posix_spawn_file_actions_destroy(&actions);
+    return res;
+}
+
+pid_t spawnCommand(string const& _command, int _stdin, int _stdout, int _stderr)
+{
+    SpawnCommand cmd = makeSpawnCommand(_command);
+    pid_t pid;
+    int res = spawnProgram(cmd, _stdin, _stdout, _stderr, pid);
+    if (res == ENOEXEC && cmd.path != "/bin/sh")
+    {
+        // A script without `#!` line, run it with the shell as the shell would do
+        cmd.argv.at(0) = cmd.path;
+        cmd.argv.insert(cmd.argv.begin(), "sh");
+        cmd.path = "/bin/sh";
+        res = spawnProgram(cmd, _stdin, _stdout, _stderr, pid);
+    }
+    return res == 0 ? pid : -1;
+}
+}  // namespace
+
+string resolveCmdPath(string const& _command)
+{
+    string const cmd = _command.substr(0, _command.find_first_of(" "));
+    std::lock_guard<std::mutex> lock(g_cmdPathsMutex);
+    auto const it = g_cmdPaths.find(cmd);
+    if (it != g_cmdPaths.end())
+        return it->second;
+
+    // Not found is not remembered, the tool might be installed later
+    string const path = findCmdPath(cmd);
+    if (!path.empty())
+        g_cmdPaths.emplace(cmd, path);
+    return path;
+}
+
+bool checkCmdExist(std::string const& _command)
+{
+    return !resolveCmdPath(_command).empty();
 }
 
-mutex g_popenmutex;
 string executeCmd(string const& _command, int& _exitCode, ExecCMDWarning _warningOnEmpty)
 {
 #if defined(_WIN32)
     BOOST_ERROR("executeCmd() has not been implemented for Windows.");
     return "";
 #else
-    string out;
-    char output[1024];
     ETH_FAIL_REQUIRE_MESSAGE(!_command.empty(), "executeCmd: empty argument!");
-
-    // TODO: do this check only once and remember that it exist? syscalls are expensive
     if (!test::checkCmdExist(_command))
         ETH_FAIL_MESSAGE("Command `" + _command + "` does not found!");
 
-    FILE* fp;
+    // Close on exec, so the pipe of this call is not inherited by processes started from other threads
+    int pout[2];
+    if (pipe2(pout, O_CLOEXEC) == -1)
+        ETH_FAIL_MESSAGE("executeCmd: failed to create pipe for " + _command);
+    pid_t const pid = spawnCommand(_command, -1, pout[1], -1);
+    close(pout[1]);
+    if (pid == -1)
     {
-        std::lock_guard<std::mutex> lock(g_popenmutex);
-        fp = popen(_command.c_str(), "r");
-    }
-    if (fp == NULL || fp == 0)
+        close(pout[0]);
         ETH_FAIL_MESSAGE("Failed to run " + _command);
-    if (fgets(output, sizeof(output) - 1, fp) == NULL)
-    {
-        if (_warningOnEmpty == ExecCMDWarning::WarningOnEmptyResult)
-            ETH_WARNING("Reading empty result for " + _command);
     }
-    else
+
+    string out;
+    char buf[65536];
+    while (true)
     {
-        while (true)
-        {
-            out += string(output);
-            if (fgets(output, sizeof(output) - 1, fp) == NULL)
-                break;
-        }
+        ssize_t const ret = read(pout[0], buf, sizeof(buf));
+        if (ret > 0)
+            out.append(buf, ret);
+        else if (ret == 0 || errno != EINTR)
+            break;
     }
+    close(pout[0]);
+
+    if (out.empty() && _warningOnEmpty == ExecCMDWarning::WarningOnEmptyResult)
+        ETH_WARNING("Reading empty result for " + _command);
 
-    _exitCode = pclose(fp);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    _exitCode = status;
     if (_exitCode != 0 )
     {
         const string msg = "The command '" + _command + "' exited with " + toString(_exitCode) + " code.";
@@ -519,6 +635,93 @@ string executeCmd(string const& _command, int& _exitCode, ExecCMDWarning _warnin
 #endif
 }
 
+string executeCmdStdio(string const& _command, string const& _stdin, int& _exitCode, string& _stderr)
+{
+    ETH_FAIL_REQUIRE_MESSAGE(!_command.empty(), "executeCmdStdio: empty argument!");
+    if (!test::checkCmdExist(_command))
+        ETH_FAIL_MESSAGE("Command `" + _command + "` does not found!");
+
+    // Close on exec, so pipes of this call are not inherited by processes started from other threads
+    int pin[2], pout[2], perr[2];
+    if (pipe2(pin, O_CLOEXEC) == -1 || pipe2(pout, O_CLOEXEC) == -1 || pipe2(perr, O_CLOEXEC) == -1)
+        ETH_FAIL_MESSAGE("executeCmdStdio: failed to create pipes for " + _command);
+
+    pid_t const pid = spawnCommand(_command, pin[0], pout[1], perr[1]);
+    close(pin[0]);
+    close(pout[1]);
+    close(perr[1]);
+    if (pid == -1)
+    {
+        close(pin[1]);
+        close(pout[0]);
+        close(perr[0]);
+        ETH_FAIL_MESSAGE("Failed to run " + _command);
+    }
+
+    // Feed stdin while draining stdout/stderr, otherwise big outputs block the child
+    string out;
+    char buf[65536];
+    size_t written = 0;
+    int fdin = pin[1];
+    fcntl(fdin, F_SETFL, O_NONBLOCK);
+    if (_stdin.empty())
+    {
+        close(fdin);
+        fdin = -1;
+    }
+    // Child may exit without reading stdin, do not let SIGPIPE kill retesteth then
+    sigset_t sigpipeMask, oldMask;
+    sigemptyset(&sigpipeMask);
+    sigaddset(&sigpipeMask, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &sigpipeMask, &oldMask);
+
+    pollfd fds[3] = {{pout[0], POLLIN, 0}, {perr[0], POLLIN, 0}, {fdin, POLLOUT, 0}};
+    while (fds[0].fd != -1 || fds[1].fd != -1)
+    {
+        if (poll(fds, 3, -1) == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        if (fds[2].fd != -1 && fds[2].revents)
+        {
+            ssize_t const ret = (fds[2].revents & POLLOUT) ? write(fdin, _stdin.c_str() + written, _stdin.size() - written) : -1;
+            if (ret > 0)
+                written += ret;
+            if (ret <= 0 || written == _stdin.size())
+            {
+                close(fdin);
+                fds[2].fd = -1;
+            }
+        }
+        for (size_t i = 0; i < 2; i++)
+        {
+            if (fds[i].fd == -1 || !fds[i].revents)
+                continue;
+            ssize_t const ret = read(fds[i].fd, buf, sizeof(buf));
+            if (ret > 0)
+                (i == 0 ? out : _stderr).append(buf, ret);
+            else
+            {
+                close(fds[i].fd);
+                fds[i].fd = -1;
+            }
+        }
+    }
+    if (fds[2].fd != -1)
+        close(fds[2].fd);
+    timespec const noWait = {0, 0};
+    if (written != _stdin.size())
+        sigtimedwait(&sigpipeMask, NULL, &noWait);
+    pthread_sigmask(SIG_SETMASK, &oldMask, NULL);
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    _exitCode = WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+    return out;
+}
+
 /// Explode string into array of strings by `delim`
 std::vector<std::string> explode(std::string const& s, char delim)
 {
@@ -553,8 +756,7 @@ std::set<std::string> explodeIntoSet(std::string const& s, char delim)
 //https://stackoverflow.com/questions/26852198/getting-the-pid-from-popen
 FILE* popen2(string const& _command, vector<string> const& _args, string const& _type, int& _pid, popenOutput _debug)
 {
-    string testIfCmdExist = "which " + _command;
-    if (system(testIfCmdExist.c_str()) == 256)
+    if (!checkCmdExist(_command))
         ETH_FAIL_MESSAGE("Command " + _command + " not found in the system!");
 
     pid_t child_pid;
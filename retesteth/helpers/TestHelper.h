@@ -63,6 +63,9 @@ std::string prepareSolidityVersionString();
 /// check system command
 bool checkCmdExist(std::string const& _command);
 
+/// full path of the program of the command, empty if not found. Looked up in PATH only once
+std::string resolveCmdPath(std::string const& _command);
+
 /// run system command
 enum class ExecCMDWarning
 {
@@ -72,6 +75,9 @@ enum class ExecCMDWarning
 };
 std::string executeCmd(std::string const& _command, int& _exitCode, ExecCMDWarning _warningOnEmpty = ExecCMDWarning::WarningOnEmptyResult);
 
+/// run system command feeding _stdin to it, return its stdout and stderr without touching the disk
+std::string executeCmdStdio(std::string const& _command, std::string const& _stdin, int& _exitCode, std::string& _stderr);
+
 // Return the vector of most looking like as _needles strings from the vector
 std::vector<std::string> levenshteinDistance(
     std::string const& _needle, std::vector<std::string> const& _sVec, size_t _max = 3);
@@ -24,6 +24,7 @@
 #include <retesteth/Options.h>
 #include <retesteth/helpers/TestHelper.h>
 #include <retesteth/helpers/TestOutputHelper.h>
+#include <retesteth/helpers/TestProfiler.h>
 
 using namespace std;
 using namespace dev;
@@ -53,19 +54,25 @@ static std::map<std::string, std::string> s_failedTestsMap;
 static std::vector<std::string> s_warningTests;
 
 mutex g_helperThreadMapMutex;
+// The map only registers helpers for printBoostError, its nodes are never erased
+thread_local TestOutputHelper* t_threadHelper = nullptr;
 TestOutputHelper& TestOutputHelper::get()
 {
+    if (t_threadHelper)
+        return *t_threadHelper;
+
     std::lock_guard<std::mutex> lock(g_helperThreadMapMutex);
     thread::id const tID = getThreadID();
-    if (helperThreadMap.count(tID))
-        return helperThreadMap.at(tID);
-    else
+    bool const isNew = !helperThreadMap.count(tID);
+    if (isNew)
     {
         TestOutputHelper instance;
         helperThreadMap.emplace(std::make_pair(tID, std::move(instance)));
-        helperThreadMap.at(tID).initTest(0);
     }
-    return helperThreadMap.at(tID);
+    t_threadHelper = &helperThreadMap.at(tID);
+    if (isNew)
+        t_threadHelper->initTest(0);
+    return *t_threadHelper;
 }
 
 void TestOutputHelper::markWarning(std::string const& _message)
@@ -172,7 +179,6 @@ void TestOutputHelper::initTest(size_t _maxTests)
     m_currentTestName = string();
     m_currentTestFileName = string();
     m_timer = TestOutputTimer();
-    TestOutputTimer::resetT8NTime();
     if (_maxTests != 0 && !Options::get().singleTestFile.initialized())
     {
         string testOutOf = "(";
@@ -300,7 +306,12 @@ void TestOutputHelper::printTestExecStats()
     }
 
     if (Options::get().exectimelog)
+    {
         TestOutputTimer::printTotalTimes();
+        TestProfiler::printTotalTimes();
+    }
+    if (Options::get().exectimeprofile.initialized())
+        TestProfiler::exportProfile(Options::get().exectimeprofile);
 
     _printTotalWarnings();
     _printTotalErrors();
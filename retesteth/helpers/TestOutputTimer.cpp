@@ -1,5 +1,6 @@
 #include "TestOutputTimer.h"
 #include <retesteth/helpers/TestHelper.h>
+#include <retesteth/helpers/TestProfiler.h>
 using namespace std;
 
 namespace  {
@@ -8,9 +9,6 @@ namespace  {
 
     std::mutex g_execTimeResults;
     static std::vector<execTimeName> execTimeResults;
-
-    std::mutex g_execT8nTimeResults;
-    static double currentT8NSubcallTime = 0;
 }
 
 namespace test {
@@ -20,37 +18,23 @@ TestOutputTimer::TestOutputTimer()
     restart();
 }
 
-void TestOutputTimer::resetT8NTime()
-{
-    std::lock_guard<std::mutex> lock(g_execT8nTimeResults);
-    currentT8NSubcallTime = 0;
-}
-
 void TestOutputTimer::restart()
 {
     m_timerTotal = dev::Timer();
     m_timerCPU = dev::CPUTimer();
+    m_t8nTimeAtStart = TestProfiler::totalTime(ProfilePhase::ToolExecution);
 }
 
-void TestOutputTimer::startSubcallTimer()
+double TestOutputTimer::getT8NTime() const
 {
-    m_timerClient.restart();
-}
-
-void TestOutputTimer::finishSubcallTimer()
-{
-    std::lock_guard<std::mutex> lock(g_execT8nTimeResults);
-    currentT8NSubcallTime += m_timerClient.elapsed();
+    // Tool calls of all threads since the timer started. The timer is run by the main thread for a test folder,
+    // whose tests run on the workers, and joins them before it finishes. Shared helpers are counted as well
+    return TestProfiler::totalTime(ProfilePhase::ToolExecution) - m_t8nTimeAtStart;
 }
 
 void TestOutputTimer::printFinishTest(string const& _testName) const
 {
-    double t8nTimeRecorded;
-    {
-        std::lock_guard<std::mutex> lock(g_execT8nTimeResults);
-        t8nTimeRecorded = currentT8NSubcallTime;
-    }
-    const execTimeName res = { _testName, getTotalTimer(), getTotalCPU(), t8nTimeRecorded };
+    const execTimeName res = { _testName, getTotalTimer(), getTotalCPU(), getT8NTime() };
     auto const& test = std::get<0>(res);
     auto const& time = std::get<1>(res);
     auto const& cputime = std::get<2>(res);
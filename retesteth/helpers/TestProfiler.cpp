@@ -0,0 +1,200 @@
+#include "TestProfiler.h"
+#include <retesteth/EthChecks.h>
+#include <retesteth/Options.h>
+#include <retesteth/helpers/TestOutputHelper.h>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+using namespace test::debug;
+namespace fs = boost::filesystem;
+
+namespace
+{
+using test::ProfilePhase;
+size_t const c_phaseCount = (size_t)ProfilePhase::Test + 1;
+
+struct ProfileEvent
+{
+    ProfilePhase phase;
+    string label;
+    string test;
+    int64_t startUs;
+    int64_t durationUs;
+};
+
+// Events of one thread. The mutex is only contended while the profile is exported
+struct ThreadProfile
+{
+    size_t tid;
+    mutex eventsMutex;
+    vector<ProfileEvent> events;
+};
+
+steady_clock::time_point const g_profileStart = steady_clock::now();
+atomic<int64_t> g_phaseTimeUs[c_phaseCount];
+thread_local int64_t t_phaseTimeUs[c_phaseCount] = {};
+thread_local size_t t_phaseDepth[c_phaseCount] = {};
+
+mutex g_threadProfilesMutex;
+vector<unique_ptr<ThreadProfile>> g_threadProfiles;
+thread_local ThreadProfile* t_threadProfile = nullptr;
+
+ThreadProfile& threadProfile()
+{
+    if (t_threadProfile == nullptr)
+    {
+        lock_guard<mutex> lock(g_threadProfilesMutex);
+        g_threadProfiles.emplace_back(new ThreadProfile());
+        g_threadProfiles.back()->tid = g_threadProfiles.size();
+        t_threadProfile = g_threadProfiles.back().get();
+    }
+    return *t_threadProfile;
+}
+
+string escapeJson(string const& _str)
+{
+    std::ostringstream out;
+    for (char const c : _str)
+    {
+        if (c == '"' || c == '\\')
+            out << '\\' << c;
+        else if ((unsigned char)c < 0x20)
+            out << "\\u" << std::hex << setw(4) << setfill('0') << (int)c << std::dec;
+        else
+            out << c;
+    }
+    return out.str();
+}
+}  // namespace
+
+namespace test
+{
+ProfileScope::ProfileScope(ProfilePhase _phase, string const& _label)
+  : m_phase(_phase), m_enabled(TestProfiler::enabled())
+{
+    if (m_enabled)
+    {
+        m_label = _label;
+        m_nested = t_phaseDepth[(size_t)_phase]++ > 0;
+        m_start = steady_clock::now();
+    }
+}
+
+ProfileScope::~ProfileScope()
+{
+    if (m_enabled)
+    {
+        t_phaseDepth[(size_t)m_phase]--;
+        TestProfiler::record(m_phase, m_label, m_start, steady_clock::now(), m_nested);
+    }
+}
+
+bool TestProfiler::enabled()
+{
+    auto const& opt = Options::get();
+    return opt.exectimelog || opt.exectimeprofile.initialized();
+}
+
+void TestProfiler::record(
+    ProfilePhase _phase, string const& _label, steady_clock::time_point _start, steady_clock::time_point _end, bool _nested)
+{
+    int64_t const durationUs = duration_cast<microseconds>(_end - _start).count();
+    if (!_nested)
+    {
+        g_phaseTimeUs[(size_t)_phase] += durationUs;
+        t_phaseTimeUs[(size_t)_phase] += durationUs;
+    }
+
+    if (!Options::get().exectimeprofile.initialized())
+        return;
+
+    ProfileEvent event;
+    event.phase = _phase;
+    event.label = _label;
+    event.test = TestOutputHelper::get().testName();
+    event.startUs = duration_cast<microseconds>(_start - g_profileStart).count();
+    event.durationUs = durationUs;
+
+    ThreadProfile& profile = threadProfile();
+    lock_guard<mutex> lock(profile.eventsMutex);
+    profile.events.emplace_back(std::move(event));
+}
+
+double TestProfiler::totalTime(ProfilePhase _phase)
+{
+    return (double)g_phaseTimeUs[(size_t)_phase] / 1000000;
+}
+
+double TestProfiler::threadTime(ProfilePhase _phase)
+{
+    return (double)t_phaseTimeUs[(size_t)_phase] / 1000000;
+}
+
+string TestProfiler::phaseName(ProfilePhase _phase)
+{
+    switch (_phase)
+    {
+    case ProfilePhase::ParseFiller: return "parse filler";
+    case ProfilePhase::CompileCode: return "compile code";
+    case ProfilePhase::SignTransactions: return "sign transactions";
+    case ProfilePhase::PrepareInputs: return "prepare inputs";
+    case ProfilePhase::ToolExecution: return "tool execution";
+    case ProfilePhase::ParseOutput: return "parse output";
+    case ProfilePhase::CompareState: return "compare state";
+    case ProfilePhase::WriteOutput: return "write output";
+    case ProfilePhase::Test: return "test";
+    }
+    return "unknown";
+}
+
+void TestProfiler::printTotalTimes()
+{
+    // The test phase includes all the others
+    double const testTime = std::max(1., totalTime(ProfilePhase::Test));
+    std::cout << "*** Execution phase stats (all threads)" << std::endl;
+    for (size_t i = 0; i < c_phaseCount - 1; i++)
+    {
+        double const time = totalTime((ProfilePhase)i);
+        std::cout << std::left << std::fixed << setprecision(2) << setw(37) << phaseName((ProfilePhase)i)
+                  << " time: " << setw(8) << time << " (" << (int)floor(100 * time / testTime) << "%)\n";
+    }
+    std::cout << "\n";
+}
+
+void TestProfiler::exportProfile(fs::path const& _file)
+{
+    std::ofstream out(_file.string());
+    if (!out)
+    {
+        ETH_WARNING("Could not write execution profile to `" + _file.string() + "`");
+        return;
+    }
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"retesteth\"}}";
+    lock_guard<mutex> lock(g_threadProfilesMutex);
+    for (auto const& profile : g_threadProfiles)
+    {
+        lock_guard<mutex> lockEvents(profile->eventsMutex);
+        out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << profile->tid
+            << ",\"args\":{\"name\":\"thread " << profile->tid << "\"}}";
+        for (auto const& event : profile->events)
+        {
+            string const& name = event.label.empty() ? phaseName(event.phase) : event.label;
+            out << ",\n{\"name\":\"" << escapeJson(name) << "\",\"cat\":\"" << phaseName(event.phase)
+                << "\",\"ph\":\"X\",\"ts\":" << event.startUs << ",\"dur\":" << event.durationUs
+                << ",\"pid\":1,\"tid\":" << profile->tid << ",\"args\":{\"test\":\"" << escapeJson(event.test) << "\"}}";
+        }
+    }
+    out << "\n]}\n";
+    ETH_DC_MESSAGE(DC::STATS, "Execution profile written to `" + _file.string() + "`");
+}
+
+}  // namespace test
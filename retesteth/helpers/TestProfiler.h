@@ -0,0 +1,64 @@
+#pragma once
+#include <boost/filesystem/path.hpp>
+#include <chrono>
+#include <string>
+
+namespace test
+{
+// Phases of a test run timed with --exectimelog and --exectimeprofile
+enum class ProfilePhase
+{
+    ParseFiller,
+    CompileCode,
+    SignTransactions,
+    PrepareInputs,
+    ToolExecution,
+    ParseOutput,
+    CompareState,
+    WriteOutput,
+    Test
+};
+
+// Times the enclosing block as a phase of the current test on this thread
+// Does nothing unless one of the profiling options is set
+// A scope nested in a scope of the same phase is exported, but not counted in the phase times again
+class ProfileScope
+{
+public:
+    ProfileScope(ProfilePhase _phase, std::string const& _label = std::string());
+    ~ProfileScope();
+    ProfileScope(ProfileScope const&) = delete;
+    void operator=(ProfileScope const&) = delete;
+
+private:
+    ProfilePhase m_phase;
+    bool m_enabled;
+    bool m_nested = false;
+    std::string m_label;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+class TestProfiler
+{
+public:
+    static bool enabled();
+
+    // Seconds spent in _phase, summed over all threads
+    static double totalTime(ProfilePhase _phase);
+
+    // Seconds spent in _phase on this thread
+    static double threadTime(ProfilePhase _phase);
+    static std::string phaseName(ProfilePhase _phase);
+    static void printTotalTimes();
+
+    // Write every recorded phase as a Chrome trace event (chrome://tracing, ui.perfetto.dev)
+    // Each thread is a separate track, events carry the name of the test they belong to
+    static void exportProfile(boost::filesystem::path const& _file);
+
+private:
+    friend class ProfileScope;
+    static void record(ProfilePhase _phase, std::string const& _label, std::chrono::steady_clock::time_point _start,
+        std::chrono::steady_clock::time_point _end, bool _nested);
+};
+
+}  // namespace test
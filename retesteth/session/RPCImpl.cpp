@@ -236,16 +236,7 @@ std::string RPCImpl::sendRawRequest(std::string const& _request)
 spDataObject RPCImpl::rpcCall(
     std::string const& _methodName, std::vector<std::string> const& _args, bool _canFail)
 {
-    string request = "{\"jsonrpc\":\"2.0\",\"method\":\"" + _methodName + "\",\"params\":[";
-    for (size_t i = 0; i < _args.size(); ++i)
-    {
-        request += _args[i];
-        if (i + 1 != _args.size())
-            request += ", ";
-    }
-
-    request += "],\"id\":" + to_string(m_rpcSequence++) + "}";
-
+    string const request = makeRequest({_methodName, _args});
     ETH_DC_MESSAGE(DC::RPC, "Request: " + request);
     JsonObjectValidator validator;  // read response while counting `{}`
     string reply = m_socket.sendRequest(request, validator);
@@ -288,6 +279,120 @@ spDataObject RPCImpl::rpcCall(
     return result.getContent().atKeyPointer("result");
 }
 
+string RPCImpl::makeRequest(RPCBatchCall const& _call)
+{
+    string request = "{\"jsonrpc\":\"2.0\",\"method\":\"" + _call.method + "\",\"params\":[";
+    for (size_t i = 0; i < _call.args.size(); ++i)
+    {
+        request += _call.args[i];
+        if (i + 1 != _call.args.size())
+            request += ", ";
+    }
+    request += "],\"id\":" + to_string(m_rpcSequence++) + "}";
+    return request;
+}
+
+// Find the call of the response by its id and return the result, fail on error
+spDataObject RPCImpl::readCallResponse(spDataObject& _response, size_t _firstId, std::vector<RPCBatchCall> const& _calls, size_t& _index)
+{
+    _index = _response->count("id") && _response->atKey("id").type() == DataType::Integer ?
+                 _response->atKey("id").asInt() - _firstId : _calls.size();
+    if (_index >= _calls.size())
+        ETH_FAIL_MESSAGE("JSON-RPC response has unexpected id: " + _response->asJson(0, false));
+    if (_response->count("error"))
+    {
+        DataObject const& error = _response->atKey("error");
+        string const errorStr = error.type() == DataType::Object ? error.atKey("message").asString() : error.asString();
+        test::TestOutputHelper const& helper = test::TestOutputHelper::get();
+        string const message = "Error on JSON-RPC call (" + helper.testInfo().errorDebug() + "):\nRequest: '" +
+                               _calls.at(_index).method + "'\nResult: '" + errorStr + "'\n";
+        m_lastInterfaceError = RPCError(errorStr, message);
+        ETH_FAIL_MESSAGE(m_lastInterfaceError.message());
+    }
+    if (!_response->count("result"))
+        ETH_FAIL_MESSAGE("JSON-RPC response has no result: " + _response->asJson(0, false));
+    return _response.getContent().atKeyPointer("result");
+}
+
+std::vector<spDataObject> RPCImpl::rpcBatch(std::vector<RPCBatchCall> const& _calls)
+{
+    std::vector<spDataObject> results;
+    if (m_batchUnsupported || _calls.empty())
+        return results;
+
+    size_t const firstId = m_rpcSequence;
+    string request = "[";
+    for (auto const& call : _calls)
+    {
+        if (request.size() > 1)
+            request += ",";
+        request += makeRequest(call);
+    }
+    request += "]";
+
+    ETH_DC_MESSAGE(DC::RPC, "Request: " + request);
+    JsonObjectValidator validator;
+    string const reply = m_socket.sendRequest(request, validator);
+    ETH_DC_MESSAGE(DC::RPC, "Reply: `" + reply + "`");
+    if (ExitHandler::receivedExitSignal())
+        return results;
+
+    // Clients that do not know batches answer with a single error object
+    spDataObject response = ConvertJsoncppStringToData(reply);
+    if (response->type() != DataType::Array || response->getSubObjects().size() != _calls.size())
+    {
+        ETH_DC_MESSAGE(DC::RPC, "Client does not support JSON-RPC batch requests, fall back to single calls");
+        m_batchUnsupported = true;
+        return results;
+    }
+
+    // Responses in a batch may come in any order
+    results.resize(_calls.size());
+    for (auto& el : (*response).getSubObjectsUnsafe())
+    {
+        size_t index = 0;
+        spDataObject result = readCallResponse(el, firstId, _calls, index);
+        results.at(index) = result;
+    }
+    m_lastInterfaceError.clear();
+    return results;
+}
+
+bool RPCImpl::rpcPipeline(std::vector<RPCBatchCall> const& _calls, size_t _window, PipelineCallback const& _onResult)
+{
+    size_t const firstId = m_rpcSequence;
+    std::vector<string> requests;
+    requests.reserve(_calls.size());
+    for (auto const& call : _calls)
+    {
+        requests.emplace_back(makeRequest(call));
+        ETH_DC_MESSAGE(DC::RPC, "Request: " + requests.back());
+    }
+
+    // Replies of the requests in flight are still read if the processing fails
+    std::exception_ptr failure;
+    m_socket.sendRequests(requests, _window, [&](string const& _reply) {
+        if (failure)
+            return;
+        try
+        {
+            ETH_DC_MESSAGE(DC::RPC, "Reply: `" + _reply + "`");
+            spDataObject response = ConvertJsoncppStringToData(_reply);
+            size_t index = 0;
+            spDataObject result = readCallResponse(response, firstId, _calls, index);
+            _onResult(index, result);
+        }
+        catch (...)
+        {
+            failure = std::current_exception();
+        }
+    });
+    if (failure)
+        std::rethrow_exception(failure);
+    m_lastInterfaceError.clear();
+    return true;
+}
+
 Socket::SocketType RPCImpl::getSocketType() const
 {
     return m_socket.type();
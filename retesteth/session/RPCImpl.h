@@ -57,12 +57,20 @@ public:
     spDataObject rpcCall(std::string const& _methodName,
         std::vector<std::string> const& _args = std::vector<std::string>(),
         bool _canFail = false) override;
+    std::vector<spDataObject> rpcBatch(std::vector<RPCBatchCall> const& _calls) override;
+    bool rpcPipeline(std::vector<RPCBatchCall> const& _calls, size_t _window, PipelineCallback const& _onResult) override;
     Socket::SocketType getSocketType() const override;
     std::string const& getSocketPath() const override;
+    SocketStats const& getSocketStats() const { return m_socket.stats(); }
 
 private:
+    std::string makeRequest(RPCBatchCall const& _call);
+    spDataObject readCallResponse(
+        spDataObject& _response, size_t _firstId, std::vector<RPCBatchCall> const& _calls, size_t& _index);
+
     Socket m_socket;
     size_t m_rpcSequence = 1;
+    bool m_batchUnsupported = false;
 };
 
 }  // namespace test::session
@@ -27,6 +27,7 @@
 #include <retesteth/helpers/TestHelper.h>
 #include <retesteth/session/RPCImpl.h>
 #include <retesteth/session/ToolImpl.h>
+#include <atomic>
 #include <csignal>
 
 using namespace std;
@@ -63,6 +64,17 @@ void closeSession(thread::id const& _threadID);
 std::mutex g_socketMapMutex;
 static std::map<thread::id, sessionInfo> socketMap;
 
+// Session of this thread, looked up without the socketMap lock
+// Increase the generation when a socketMap entry is erased or given to another thread
+std::atomic<size_t> g_socketMapGeneration = 1;
+struct ThreadSession
+{
+    size_t generation = 0;
+    unsigned configId = 0;
+    SessionInterface* session = nullptr;
+};
+thread_local ThreadSession t_threadSession;
+
 void RPCSession::runNewInstanceOfAClient(thread::id const& _threadID, ClientConfig const& _config)
 {
     switch (_config.cfgFile().socketType())
@@ -248,9 +260,14 @@ void RPCSession::restartScripts(bool _stop)
 
 SessionInterface& RPCSession::instance(thread::id const& _threadID)
 {
+    test::ClientConfigID currentConfigId = Options::getDynamicOptions().getCurrentConfig().getId();
+    bool const isThisThread = _threadID == this_thread::get_id();
+    if (isThisThread && t_threadSession.session && t_threadSession.configId == currentConfigId.id() &&
+        t_threadSession.generation == g_socketMapGeneration.load(std::memory_order_acquire))
+        return *t_threadSession.session;
+
     std::lock_guard<std::mutex> lock(g_socketMapMutex);
     bool needToCreateNew = false;
-    test::ClientConfigID currentConfigId = Options::getDynamicOptions().getCurrentConfig().getId();
     if (socketMap.count(_threadID) && socketMap.at(_threadID).configId != currentConfigId)
     {
         // For this thread a session is opened but it is opened not for current tested client
@@ -271,6 +288,7 @@ SessionInterface& RPCSession::instance(thread::id const& _threadID)
                     socket.second.isUsed = SessionStatus::Working;
                     socketMap.insert(std::pair<thread::id, sessionInfo>(_threadID, std::move(socket.second)));
                     socketMap.erase(socketMap.find(socket.first));  // remove previous threadID assigment to this socket
+                    g_socketMapGeneration++;
                     assert(socketMap.count(_threadID));
                     return socketMap.at(_threadID).session.get()->getImplementation();
                 }
@@ -296,7 +314,14 @@ SessionInterface& RPCSession::instance(thread::id const& _threadID)
     size_t const threadID = std::hash<std::thread::id>()(_threadID);
     ETH_FAIL_REQUIRE_MESSAGE(
         socketMap.count(_threadID), "ThreadID: `" + fto_string(threadID) + "` not registered in socketMap!");
-    return socketMap.at(_threadID).session.get()->getImplementation();
+    SessionInterface& session = socketMap.at(_threadID).session.get()->getImplementation();
+    if (isThisThread)
+    {
+        t_threadSession.generation = g_socketMapGeneration.load(std::memory_order_acquire);
+        t_threadSession.configId = currentConfigId.id();
+        t_threadSession.session = &session;
+    }
+    return session;
 }
 
 void RPCSession::sessionStart(thread::id const& _threadID)
@@ -348,6 +373,7 @@ void RPCSession::clear()
         th.join();
 
     socketMap.clear();
+    g_socketMapGeneration++;
     closingThreads.clear();
 
     // If not running UnitTests or smth
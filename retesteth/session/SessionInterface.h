@@ -3,6 +3,7 @@
 #include <libdataobj/DataObject.h>
 #include <retesteth/testStructures/basetypes.h>
 #include <retesteth/testStructures/types/rpc.h>
+#include <functional>
 #include <string>
 
 namespace test::session
@@ -36,6 +37,13 @@ private:
 using namespace dataobject;
 using namespace test::teststruct;
 
+// One call of JSON-RPC batch request
+struct RPCBatchCall
+{
+    std::string method;
+    std::vector<std::string> args;
+};
+
 class SessionInterface
 {
 public:
@@ -75,14 +83,45 @@ public:
     virtual FH32 test_getLogHash(FH32 const& _txHash) = 0;
     virtual void test_registerWithdrawal(BYTES const& _rlp) = 0;
     virtual TestRawTransaction test_rawTransaction(BYTES const& _rlp, FORK const& _fork) = 0;
+    // Validate transactions with one call, results are returned in order of _rlps
+    // Empty result means the client does not support it and transactions must be sent one by one
+    virtual std::vector<TestRawTransaction> test_rawTransactions(std::vector<BYTES> const& _rlps, FORK const& _fork)
+    {
+        (void)_rlps;
+        (void)_fork;
+        return std::vector<TestRawTransaction>();
+    }
     virtual std::string test_rawEOFCode(BYTES const& _code, FORK const& _fork) = 0;
     virtual VALUE test_calculateDifficulty(FORK const& _fork, VALUE const& _blockNumber, VALUE const& _parentTimestamp,
         VALUE const& _parentDifficulty, VALUE const& _currentTimestamp, VALUE const& _uncleNumber) = 0;
 
+    // Post state of the last block, shared with the in process backend chain and must not be modified
+    // Empty for remote clients, the state is then read with debug_accountRange / debug_storageRangeAt
+    virtual spState lastBlockState() { return spState(0); }
+
     // Internal
     virtual spDataObject rpcCall(std::string const& _methodName,
         std::vector<std::string> const& _args = std::vector<std::string>(),
         bool _canFail = false) = 0;
+
+    // Send calls as one JSON-RPC 2.0 batch, results are returned in order of calls
+    // Empty result means the client does not support batch requests and calls must be sent one by one
+    virtual std::vector<spDataObject> rpcBatch(std::vector<RPCBatchCall> const& _calls)
+    {
+        (void)_calls;
+        return std::vector<spDataObject>();
+    }
+
+    // Send calls keeping up to _window requests in flight, results are passed to _onResult(callIndex, result) as they arrive
+    // Returns false if the client can not pipeline and calls must be sent one by one
+    typedef std::function<void(size_t, spDataObject&)> PipelineCallback;
+    virtual bool rpcPipeline(std::vector<RPCBatchCall> const& _calls, size_t _window, PipelineCallback const& _onResult)
+    {
+        (void)_calls;
+        (void)_window;
+        (void)_onResult;
+        return false;
+    }
     virtual Socket::SocketType getSocketType() const = 0;
     virtual std::string const& getSocketPath() const = 0;
 
@@ -6,6 +6,7 @@
 #include <memory>
 
 using namespace std;
+using namespace test::debug;
 
 namespace test::session
 {
@@ -147,48 +148,6 @@ static size_t readcallback(void* dest, size_t size, size_t nmemb, void* userp)
     return 0; /* no more data left to deliver */
 }
 
-string sendRequestTCP(string const& _req, string const& _address)
-{
-    CURL* curl;
-    CURLcode res;
-    curl = curl_easy_init();
-
-    string url = _address;
-    if (_address.find("http") == string::npos)
-        url = "http://" + _address;
-    if (curl)
-    {
-        std::unique_ptr<std::string> httpData(new std::string());
-        struct WriteThis wt;
-        wt.readptr = _req.c_str();
-        wt.sizeleft = _req.size();
-
-        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(curl, CURLOPT_BUFFERSIZE, 3000000);
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writecallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, httpData.get());
-        curl_easy_setopt(curl, CURLOPT_READFUNCTION, readcallback);
-        curl_easy_setopt(curl, CURLOPT_READDATA, &wt);
-        curl_easy_setopt(curl, CURLOPT_POST, 1L);
-
-        struct curl_slist* header = NULL;
-        header = curl_slist_append(header, "Accept: application/json, text/plain");
-        header = curl_slist_append(header, "Content-Type: application/json");
-        header = curl_slist_append(header, "Transfer-Encoding: chunked");
-
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, header);
-        curl_easy_setopt(curl, CURLOPT_TIMEOUT, 500L);
-        res = curl_easy_perform(curl);
-        if (res != CURLE_OK && !ExitHandler::receivedExitSignal())
-            ETH_FAIL_MESSAGE("curl_easy_perform() failed " + string(curl_easy_strerror(res)));
-        curl_slist_free_all(header);
-        curl_easy_cleanup(curl);
-        return *httpData.get();
-    }
-    else
-        ETH_FAIL_MESSAGE("Error initializing Curl");
-    return string();
-}
 }  // namespace
 
 string Socket::sendRequestIPC(string const& _req, SocketResponseValidator& _validator)
@@ -228,25 +187,242 @@ string Socket::sendRequestIPC(string const& _req, SocketResponseValidator& _vali
     return reply;
 }
 
+void* Socket::newCurlHandle()
+{
+    if (!m_curlHeader)
+    {
+        m_curlUrl = m_path;
+        if (m_path.find("http") == string::npos)
+            m_curlUrl = "http://" + m_path;
+
+        m_curlHeader = curl_slist_append(m_curlHeader, "Accept: application/json, text/plain");
+        m_curlHeader = curl_slist_append(m_curlHeader, "Content-Type: application/json");
+        m_curlHeader = curl_slist_append(m_curlHeader, "Transfer-Encoding: chunked");
+    }
+
+    CURL* curl = curl_easy_init();
+    if (!curl)
+        ETH_FAIL_MESSAGE("Error initializing Curl");
+
+    curl_easy_setopt(curl, CURLOPT_URL, m_curlUrl.c_str());
+    curl_easy_setopt(curl, CURLOPT_BUFFERSIZE, 3000000);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writecallback);
+    curl_easy_setopt(curl, CURLOPT_READFUNCTION, readcallback);
+    curl_easy_setopt(curl, CURLOPT_POST, 1L);
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, m_curlHeader);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 500L);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
+    return curl;
+}
+
+string Socket::sendRequestTCP(string const& _req)
+{
+    if (!m_curl)
+        m_curl = newCurlHandle();
+
+    string httpData;
+    struct WriteThis wt;
+    wt.readptr = _req.c_str();
+    wt.sizeleft = _req.size();
+    curl_easy_setopt(m_curl, CURLOPT_WRITEDATA, &httpData);
+    curl_easy_setopt(m_curl, CURLOPT_READDATA, &wt);
+
+    CURLcode const res = curl_easy_perform(m_curl);
+    if (res != CURLE_OK && !ExitHandler::receivedExitSignal())
+        ETH_FAIL_MESSAGE("curl_easy_perform() failed " + string(curl_easy_strerror(res)));
+    return httpData;
+}
+
+// Up to _window http requests run at the same time on separate keep-alive connections of the multi handle
+void Socket::sendRequestsTCP(std::vector<string> const& _reqs, size_t _window, ReplyCallback const& _onReply)
+{
+    if (!m_curlMulti)
+        m_curlMulti = curl_multi_init();
+    while (m_curlPool.size() < _window)
+        m_curlPool.emplace_back(newCurlHandle());
+    for (void* curl : m_curlPool)
+        curl_multi_remove_handle(m_curlMulti, curl);  // left from interrupted run
+
+    struct Transfer
+    {
+        string reply;
+        WriteThis wt;
+    };
+    std::vector<Transfer> transfers(_window);
+
+    size_t next = 0;
+    auto startTransfer = [&](size_t _slot) {
+        Transfer& tr = transfers.at(_slot);
+        tr.reply.clear();
+        tr.wt.readptr = _reqs.at(next).c_str();
+        tr.wt.sizeleft = _reqs.at(next).size();
+        next++;
+        CURL* curl = m_curlPool.at(_slot);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &tr.reply);
+        curl_easy_setopt(curl, CURLOPT_READDATA, &tr.wt);
+        curl_easy_setopt(curl, CURLOPT_PRIVATE, (void*)_slot);
+        curl_multi_add_handle(m_curlMulti, curl);
+    };
+
+    for (size_t slot = 0; slot < _window && next < _reqs.size(); slot++)
+        startTransfer(slot);
+
+    size_t received = 0;
+    while (received < _reqs.size() && !ExitHandler::receivedExitSignal())
+    {
+        int running = 0;
+        curl_multi_perform(m_curlMulti, &running);
+
+        int left = 0;
+        while (CURLMsg* msg = curl_multi_info_read(m_curlMulti, &left))
+        {
+            if (msg->msg != CURLMSG_DONE)
+                continue;
+            CURL* curl = msg->easy_handle;
+            CURLcode const res = msg->data.result;
+            void* slotPtr = nullptr;
+            curl_easy_getinfo(curl, CURLINFO_PRIVATE, &slotPtr);
+            size_t const slot = (size_t)slotPtr;
+            curl_multi_remove_handle(m_curlMulti, curl);
+            if (res != CURLE_OK)
+                ETH_FAIL_MESSAGE("curl_multi_perform() failed " + string(curl_easy_strerror(res)));
+
+            received++;
+            string const reply = std::move(transfers.at(slot).reply);
+            if (next < _reqs.size())
+                startTransfer(slot);
+            _onReply(reply);
+        }
+
+        if (running)
+            curl_multi_wait(m_curlMulti, NULL, 0, 1000, NULL);
+    }
+}
+
+// Requests are written ahead of replies, replies are split from the stream by balancing {} outside of strings
+void Socket::sendRequestsIPC(std::vector<string> const& _reqs, size_t _window, ReplyCallback const& _onReply)
+{
+    size_t next = 0;
+    auto sendNext = [&]() {
+        string const& req = _reqs.at(next++);
+        if (send(m_socket, req.c_str(), req.length(), 0) != (ssize_t)req.length())
+            ETH_FAIL_MESSAGE("Writing on socket failed.");
+    };
+    while (next < _window && next < _reqs.size())
+        sendNext();
+
+    string buffer;
+    size_t scanned = 0;
+    JsonStreamScanner scanner;
+    size_t received = 0;
+    while (received < _reqs.size() && !ExitHandler::receivedExitSignal())
+    {
+        ssize_t const ret = recv(m_socket, m_readBuf, sizeof(m_readBuf), 0);
+        if (ret <= 0)
+            ETH_FAIL_MESSAGE("Reading on socket failed!");
+        buffer.append(m_readBuf, ret);
+
+        while (scanned < buffer.size())
+        {
+            if (scanner.accept(buffer[scanned++]))
+            {
+                string const reply = buffer.substr(0, scanned);
+                buffer.erase(0, scanned);
+                scanned = 0;
+                received++;
+                if (next < _reqs.size())
+                    sendNext();
+                _onReply(reply);
+            }
+        }
+    }
+}
+
+void Socket::sendRequests(std::vector<string> const& _reqs, size_t _window, ReplyCallback const& _onReply)
+{
+    if (_reqs.empty())
+        return;
+    _window = max<size_t>(1, min(_window, _reqs.size()));
+
+    auto const start = chrono::steady_clock::now();
+    if (m_socketType == Socket::TCP)
+        sendRequestsTCP(_reqs, _window, _onReply);
+    else if (m_socketType == Socket::IPC)
+        sendRequestsIPC(_reqs, _window, _onReply);
+
+    double const ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    m_stats.requests += _reqs.size();
+    m_stats.totalMs += ms;
+    m_stats.maxMs = max(m_stats.maxMs, ms / _reqs.size());
+}
+
 string Socket::sendRequest(string const& _req, SocketResponseValidator& _val)
 {
 #if defined(_WIN32)
     return sendRequestWin(_req);
 #endif
 
+    auto const start = chrono::steady_clock::now();
+    string reply;
     if (m_socketType == Socket::TCP)
-        return sendRequestTCP(_req, m_path);
+        reply = sendRequestTCP(_req);
+    else if (m_socketType == Socket::IPC)
+        reply = sendRequestIPC(_req, _val);
+
+    double const ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    m_stats.requests++;
+    m_stats.totalMs += ms;
+    m_stats.maxMs = max(m_stats.maxMs, ms);
+    return reply;
+}
+
+Socket::~Socket()
+{
+    for (void* curl : m_curlPool)
+    {
+        if (m_curlMulti)
+            curl_multi_remove_handle(m_curlMulti, curl);
+        curl_easy_cleanup(curl);
+    }
+    if (m_curlMulti)
+        curl_multi_cleanup(m_curlMulti);
+    if (m_curl)
+        curl_easy_cleanup(m_curl);
+    if (m_curlHeader)
+        curl_slist_free_all(m_curlHeader);
+    close(m_socket);
+    if (m_stats.requests)
+        ETH_DC_MESSAGE(DC::SOCKET, "Socket `" + m_path + "` requests: " + to_string(m_stats.requests) +
+                                       ", avg: " + to_string(m_stats.averageMs()) + "ms, max: " +
+                                       to_string(m_stats.maxMs) + "ms");
+}
 
-    if (m_socketType == Socket::IPC)
-        return sendRequestIPC(_req, _val);
+bool JsonStreamScanner::accept(char _c)
+{
+    if (m_inString)
+    {
+        if (m_escaped)
+            m_escaped = false;
+        else if (_c == '\\')
+            m_escaped = true;
+        else if (_c == '"')
+            m_inString = false;
+        return false;
+    }
 
-    return string();
+    if (_c == '"')
+        m_inString = true;
+    else if (_c == '{' || _c == '[')
+        m_depth++;
+    else if (_c == '}' || _c == ']')
+        return --m_depth == 0;
+    return false;
 }
 
 JsonObjectValidator::JsonObjectValidator()
 {
     m_status = false;
-    m_bracersCount = 0;
     m_response = string();
 }
 void JsonObjectValidator::acceptResponse(std::string const& _response)
@@ -254,16 +430,10 @@ void JsonObjectValidator::acceptResponse(std::string const& _response)
     for (size_t i = 0; i < _response.size(); i++)
     {
         m_response += _response[i];
-        if (_response[i] == '{')
-            m_bracersCount++;
-        else if (_response[i] == '}')
+        if (m_scanner.accept(_response[i]))
         {
-            m_bracersCount--;
-            if (m_bracersCount == 0)
-            {
-                m_status = true;
-                break;
-            }
+            m_status = true;
+            break;
         }
     }
 }
@@ -11,7 +11,11 @@
 #endif
 
 #include <boost/noncopyable.hpp>
+#include <functional>
 #include <string>
+#include <vector>
+
+struct curl_slist;
 
 namespace test::session
 {
@@ -23,6 +27,20 @@ public:
     virtual std::string const& getResponse() const = 0;
 };
 
+// Finds the end of a top level JSON object or array in a character stream
+// Brackets inside of JSON strings (error messages, revert reasons) are not counted
+class JsonStreamScanner
+{
+public:
+    // Returns true when _c closes the top level object
+    bool accept(char _c);
+
+private:
+    int m_depth = 0;
+    bool m_inString = false;
+    bool m_escaped = false;
+};
+
 class JsonObjectValidator : public SocketResponseValidator
 {
 public:
@@ -34,7 +52,16 @@ public:
 private:
     std::string m_response;
     bool m_status;
-    int m_bracersCount;
+    JsonStreamScanner m_scanner;
+};
+
+// Request latency counters of a connection
+struct SocketStats
+{
+    size_t requests = 0;
+    double totalMs = 0;
+    double maxMs = 0;
+    double averageMs() const { return requests ? totalMs / requests : 0; }
 };
 
 #if defined(_WIN32)
@@ -63,10 +90,15 @@ public:
     };
     explicit Socket(SocketType _type, std::string const& _path);
     std::string sendRequest(std::string const& _req, SocketResponseValidator& _responseValidator);
-    ~Socket() { close(m_socket); }
+
+    // Send requests keeping up to _window of them in flight, replies are passed as they arrive (in any order)
+    typedef std::function<void(std::string const&)> ReplyCallback;
+    void sendRequests(std::vector<std::string> const& _reqs, size_t _window, ReplyCallback const& _onReply);
+    ~Socket();
 
     std::string const& path() const { return m_path; }
     SocketType type() const { return m_socketType; }
+    SocketStats const& stats() const { return m_stats; }
 
 private:
     std::string m_path;
@@ -76,7 +108,20 @@ private:
     /// might take long.
     unsigned static constexpr m_readTimeOutMS = 130000;
     char m_readBuf[512000];
+    SocketStats m_stats;
+
+    // TCP: one curl handle per session keeps the http connection alive between requests
+    void* m_curl = nullptr;
+    curl_slist* m_curlHeader = nullptr;
+    std::string m_curlUrl;
+    void* m_curlMulti = nullptr;
+    std::vector<void*> m_curlPool;
+
+    void* newCurlHandle();
     std::string sendRequestIPC(std::string const& _req, SocketResponseValidator& _val);
+    std::string sendRequestTCP(std::string const& _req);
+    void sendRequestsIPC(std::vector<std::string> const& _reqs, size_t _window, ReplyCallback const& _onReply);
+    void sendRequestsTCP(std::vector<std::string> const& _reqs, size_t _window, ReplyCallback const& _onReply);
 };
 #endif
 
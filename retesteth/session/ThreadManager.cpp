@@ -4,18 +4,65 @@
 #include <retesteth/ExitHandler.h>
 #include <retesteth/Options.h>
 #include <retesteth/helpers/TestHelper.h>
+#include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <limits>
+#include <mutex>
 
-size_t g_activejobs = 0;
-std::mutex g_jobsmutex;
-std::condition_variable g_cv;
-std::mutex g_callbackmutex;
 using namespace std;
 
+namespace
+{
+typedef std::packaged_task<void()> Task;
+size_t const c_notWorker = std::numeric_limits<size_t>::max();
+
+// Every worker has own queue, takes own jobs from the back and steals from the front of the others
+std::mutex g_poolMutex;
+std::condition_variable g_poolWork;   // a job is queued or workers are stopping
+std::condition_variable g_poolSpace;  // a job is taken from a queue
+std::vector<std::thread> g_workers;
+std::vector<std::deque<Task>> g_queues;
+std::vector<std::shared_future<void>> g_pending;
+size_t g_queued = 0;
+size_t g_nextQueue = 0;
+bool g_stopWorkers = false;
+thread_local size_t t_workerIndex = c_notWorker;
+
+bool popTask(size_t _index, Task& _task)
+{
+    std::unique_lock<std::mutex> lock(g_poolMutex);
+    g_poolWork.wait(lock, []() { return g_queued > 0 || g_stopWorkers; });
+    if (g_queued == 0)
+        return false;
+
+    if (!g_queues.at(_index).empty())
+    {
+        _task = std::move(g_queues.at(_index).back());
+        g_queues.at(_index).pop_back();
+    }
+    else
+    {
+        for (size_t i = 1; i < g_queues.size(); i++)
+        {
+            auto& victim = g_queues.at((_index + i) % g_queues.size());
+            if (victim.empty())
+                continue;
+            _task = std::move(victim.front());
+            victim.pop_front();
+            break;
+        }
+    }
+    g_queued--;
+    lock.unlock();
+    g_poolSpace.notify_one();
+    return true;
+}
+}  // namespace
+
 namespace test::session
 {
 unsigned int ThreadManager::currConfigId = 0;
-map<thread::id, thread> ThreadManager::threadMap;
 using namespace test;
 
 size_t ThreadManager::getMaxAllowedThreads()
@@ -40,93 +87,193 @@ size_t ThreadManager::getMaxAllowedThreads()
     return maxAllowedThreads;
 }
 
-void ThreadManager::addTask(std::function<void()> _job)
+void ThreadManager::workerLoop(size_t _index)
 {
-    {
-         std::lock_guard<std::mutex> lk(g_jobsmutex);
-         g_activejobs++;
-    }
+    t_workerIndex = _index;
+    Task task;
+    while (popTask(_index, task))
+        task();  // exceptions are passed to the future
+}
 
-    auto wrappedJob = [_job](){
-        _job();
-        g_cv.notify_one();
-        std::lock_guard<std::mutex> lk(g_jobsmutex);
-        g_activejobs--;
-    };
-    thread workThread(wrappedJob);
-    threadMap.emplace(workThread.get_id(), std::move(workThread));
+void ThreadManager::startWorkers(size_t _count)
+{
+    std::lock_guard<std::mutex> lock(g_poolMutex);
+    g_stopWorkers = false;
+    g_queues.resize(max<size_t>(1, _count));
+    for (size_t i = 0; i < g_queues.size(); i++)
+        g_workers.emplace_back(&ThreadManager::workerLoop, i);
+}
 
-    // See how many connections we can afford on current running configuration
-    static size_t maxAllowedThreads = getMaxAllowedThreads();
-    ClientConfig const& currConfig = Options::get().getDynamicOptions().getCurrentConfig();
-    if (currConfigId != currConfig.getId().id())
+void ThreadManager::stopWorkers()
+{
     {
-        currConfigId = currConfig.getId().id();
-        maxAllowedThreads = getMaxAllowedThreads();
+        std::lock_guard<std::mutex> lock(g_poolMutex);
+        g_stopWorkers = true;
     }
-
-    // Wait for at least one connection to finish it's task
-    if (threadMap.size() == maxAllowedThreads)
+    g_poolWork.notify_all();
+    for (auto& worker : g_workers)
     {
-        waitForAtLeastOneJobToFinish();
-        joinThreads(false);
+        thread::id const id = worker.get_id();
+        worker.join();
+        // The session could be picked up by another thread
+        RPCSession::sessionEnd(id, RPCSession::SessionStatus::Available);
     }
+    g_workers.clear();
+    g_queues.clear();
 }
 
-void ThreadManager::joinThreads(bool _all)
+std::shared_future<void> ThreadManager::addTask(std::function<void()> _job)
 {
-    if (_all)
+    // See how many connections we can afford on current running configuration
+    if (t_workerIndex == c_notWorker)
     {
-        for (auto& th : threadMap)
-        {
-            th.second.join();
-            // A thread with exception thrown still being joined here!
-            RPCSession::sessionEnd(th.first, RPCSession::SessionStatus::Available);
-        }
-        threadMap.clear();
-        if (ExitHandler::receivedExitSignal())
+        ClientConfig const& currConfig = Options::get().getDynamicOptions().getCurrentConfig();
+        if (!g_workers.empty() && currConfigId != currConfig.getId().id())
+            joinThreads();
+        if (g_workers.empty())
+            startWorkers(getMaxAllowedThreads());
+    }
+
+    Task task(std::move(_job));
+    std::shared_future<void> done = task.get_future().share();
+    {
+        std::unique_lock<std::mutex> lock(g_poolMutex);
+        size_t queue = t_workerIndex;
+        if (queue == c_notWorker)
         {
-            // if one of the tests threads failed with fatal exception stop retesteth execution
-            ExitHandler::doExit();
+            // Keep the jobs in the main loop, so the progress and exit signal are checked as the tests run
+            g_poolSpace.wait(lock, []() { return g_queued < g_workers.size(); });
+            queue = g_nextQueue++ % g_queues.size();
         }
-        // otherwise continue test execution
-        return;
+        g_queues.at(queue).emplace_back(std::move(task));
+        g_queued++;
+        g_pending.emplace_back(done);
     }
+    g_poolWork.notify_one();
+    return done;
+}
 
-    bool finished = false;
-    while (!finished)
+void ThreadManager::runShared(size_t _count, std::function<void(size_t)> const& _job, std::function<void()> const& _helperDone)
+{
+    struct SharedJobs
     {
-        for (std::map<thread::id, thread>::iterator it = threadMap.begin(); it != threadMap.end(); it++)
+        std::function<void(size_t)> job;
+        std::function<void()> helperDone;
+        size_t count;
+        std::atomic<size_t> next = 0;
+        std::atomic<bool> failed = false;
+        std::vector<std::exception_ptr> errors;
+        std::mutex mutex;
+        std::condition_variable allDone;
+        size_t done = 0;
+    };
+    auto shared = std::make_shared<SharedJobs>();
+    shared->job = _job;
+    shared->helperDone = _helperDone;
+    shared->count = _count;
+    shared->errors.resize(_count);
+
+    // Helpers that start after all indexes are taken do nothing, so the job is never called after return
+    // The last index is counted done after the helper has cleaned up, so helperDone is not called after return either
+    auto work = [shared](bool _helper) {
+        bool ran = false;
+        size_t i = shared->next++;
+        while (i < shared->count)
         {
-            auto status = RPCSession::sessionStatus(it->first);
-            if (status == RPCSession::HasFinished)
+            if (!shared->failed)
+            {
+                ran = true;
+                try
+                {
+                    shared->job(i);
+                }
+                catch (...)
+                {
+                    shared->errors.at(i) = std::current_exception();
+                    shared->failed = true;
+                }
+            }
+
+            size_t const next = shared->next++;
+            if (next >= shared->count && _helper && ran && shared->helperDone)
+            {
+                try
+                {
+                    shared->helperDone();
+                }
+                catch (...)
+                {
+                    if (!shared->errors.at(i))
+                        shared->errors.at(i) = std::current_exception();
+                    shared->failed = true;
+                }
+            }
             {
-                thread::id const& id = it->first;
-                it->second.join();
-                RPCSession::sessionEnd(id, RPCSession::SessionStatus::Available);
-                threadMap.erase(it);
-                return;
+                std::lock_guard<std::mutex> lock(shared->mutex);
+                if (++shared->done == shared->count)
+                    shared->allDone.notify_all();
             }
-            else if (status == RPCSession::NotExist && ExitHandler::receivedExitSignal())
-                return;
+            i = next;
         }
+    };
+
+    size_t helpers = 0;
+    if (t_workerIndex != c_notWorker && _count > 1)
+    {
+        std::lock_guard<std::mutex> lock(g_poolMutex);
+        helpers = min(_count, g_workers.size()) - 1;
+    }
+    for (size_t i = 0; i < helpers; i++)
+        addTask([work]() { work(true); });
+    work(false);
 
-        // The session availability check is time consuming. Let other threads to work
-        if (Options::get().threadCount > 1)
-            std::this_thread::sleep_for(25ms);
+    {
+        std::unique_lock<std::mutex> lock(shared->mutex);
+        shared->allDone.wait(lock, [&shared]() { return shared->done == shared->count; });
     }
+    for (auto const& error : shared->errors)
+        if (error)
+            std::rethrow_exception(error);
 }
 
-void ThreadManager::waitForAtLeastOneJobToFinish()
+void ThreadManager::joinThreads()
 {
-    std::unique_lock<std::mutex> lkj(g_jobsmutex);
-    if (g_activejobs != 0)
+    // Jobs might add more jobs while we wait
+    std::exception_ptr failure;
+    while (true)
+    {
+        std::vector<std::shared_future<void>> pending;
+        {
+            std::lock_guard<std::mutex> lock(g_poolMutex);
+            pending.swap(g_pending);
+        }
+        if (pending.empty())
+            break;
+        for (auto const& job : pending)
+        {
+            try
+            {
+                job.get();
+            }
+            catch (...)
+            {
+                // A job with exception thrown still being waited here!
+                if (!failure)
+                    failure = std::current_exception();
+            }
+        }
+    }
+
+    if (!g_workers.empty())
+        stopWorkers();
+
+    if (ExitHandler::receivedExitSignal())
     {
-        lkj.unlock();
-        std::unique_lock<std::mutex> lk(g_callbackmutex);
-        g_cv.wait(lk);
+        // if one of the tests threads failed with fatal exception stop retesteth execution
+        ExitHandler::doExit();
     }
-    else
-        lkj.unlock();
+    if (failure)
+        std::rethrow_exception(failure);
+    // otherwise continue test execution
 }
 }  // namespace test::session
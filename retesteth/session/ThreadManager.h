@@ -1,22 +1,38 @@
 #pragma once
-#include <map>
-#include <thread>
 #include <functional>
+#include <future>
+#include <thread>
 
 namespace test::session
 {
-// Manages jobs ensuring that only as many as -j flag allows are currently running
+// Runs jobs on a pool of as many worker threads as -j flag allows
+// Each worker keeps its client session for all the jobs it executes
 // Construct over the Session class which manages new connections to the clients
 class ThreadManager
 {
 public:
-    static void joinThreads(bool _all = true);
-    static void addTask(std::function<void()> _job);
+    // Wait for all added jobs, then stop the workers and release their sessions
+    // An exception that escapes a job does not stop the other jobs, the first one is rethrown here
+    // (a raw thread used to terminate the whole run on it), test errors are reported inside the jobs
+    static void joinThreads();
+
+    // Queue the job, blocks while every worker already has a job waiting
+    // Jobs added from a worker go to its own queue without waiting and can be stolen by idle workers
+    static std::shared_future<void> addTask(std::function<void()> _job);
+
+    // Run _job(0.._count-1) on this thread, letting idle workers take some of the indexes
+    // Returns when all indexes are done and rethrows the exception of the first failed index
+    // Indexes not yet started when a job fails are skipped. Off the worker threads runs all on this thread
+    // _helperDone is called on each helper worker that ran some of the indexes, after its last index
+    static void runShared(size_t _count, std::function<void(size_t)> const& _job,
+        std::function<void()> const& _helperDone = std::function<void()>());
+
 private:
     ThreadManager() {}
-    static void waitForAtLeastOneJobToFinish();
     static size_t getMaxAllowedThreads();
-    static std::map<std::thread::id, std::thread> threadMap;
+    static void startWorkers(size_t _count);
+    static void stopWorkers();
+    static void workerLoop(size_t _index);
     static unsigned int currConfigId;
 };
 
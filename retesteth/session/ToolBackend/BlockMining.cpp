@@ -5,6 +5,7 @@
 #include <libdevcore/CommonIO.h>
 #include <retesteth/helpers/TestHelper.h>
 #include <retesteth/helpers/TestOutputHelper.h>
+#include <retesteth/helpers/TestProfiler.h>
 #include <retesteth/testStructures/Common.h>
 #include <testStructures/types/BlockchainTests/BlockchainTestFiller.h>
 #include <retesteth/Constants.h>
@@ -130,6 +131,27 @@ void makeEnvRequestHash(spDataObject& , spBlockHeader const&, spBlockHeader cons
 
 namespace toolimpl
 {
+BlockMining::BlockMining(ToolChain const& _toolChain, EthereumBlockState const& _currentBlock,
+    EthereumBlockState const& _parentBlock, SealEngine _engine)
+  : m_chainRef(_toolChain), m_currentBlockRef(_currentBlock), m_parentBlockRef(_parentBlock), m_engine(_engine)
+{
+    // Exporting the t8n call requires the files
+    if (!Options::get().t8ntoolcall.empty())
+        m_mode = T8NCallMode::File;
+    else if (!m_chainRef.t8nDaemon().isEmpty() && !m_chainRef.t8nDaemon()->timedOut())
+        m_mode = T8NCallMode::Daemon;
+    else if (Options::getCurrentConfig().cfgFile().t8nStdio())
+        m_mode = T8NCallMode::Stdio;
+    else
+        m_mode = T8NCallMode::File;
+
+    // In memory modes serialize inputs only for the debug log
+    m_serializeInputs = m_mode == T8NCallMode::File || Debug::get().flag(DC::RPC);
+
+    // Daemon that remembers its post states can take the parent post state by reference and return only changes
+    m_allocDiff = m_mode == T8NCallMode::Daemon && Options::getCurrentConfig().cfgFile().t8nDaemonAllocDiff();
+}
+
 void BlockMining::prepareEnvFile()
 {
     m_envPath = m_chainRef.tmpDir() / "env.json";
@@ -153,16 +175,35 @@ void BlockMining::prepareEnvFile()
     // Options Hook
     Options::getCurrentConfig().performFieldReplace(envData.getContent(), FieldReplaceDir::RetestethToClient);
 
-    m_envPathContent = envData->asJson();
-    writeFile(m_envPath.string(), m_envPathContent);
+    if (m_serializeInputs)
+        m_envPathContent = envData->asJson();
+    if (m_mode == T8NCallMode::File)
+        writeFile(m_envPath.string(), m_envPathContent);
+    else
+        m_envData = envData;
 }
 
 void BlockMining::prepareAllocFile()
 {
     m_allocPath = m_chainRef.tmpDir() / "alloc.json";
+
+    // Pending block state is the parent post state object unless the chain was modified
+    bool const preStateIsParentPostState =
+        &m_currentBlockRef.state().getCContent() == &m_parentBlockRef.state().getCContent();
+    if (m_allocDiff && m_engine != SealEngine::Genesis && preStateIsParentPostState)
+    {
+        m_allocRef = m_parentBlockRef.header()->stateRoot().asString();
+        m_allocPathContent = "allocRef: " + m_allocRef;
+        return;
+    }
+
     spDataObject preState = m_currentBlockRef.state()->asDataObject();
-    m_allocPathContent = preState->asJsonNoFirstKey();
-    writeFile(m_allocPath.string(), m_allocPathContent);
+    if (m_serializeInputs)
+        m_allocPathContent = preState->asJsonNoFirstKey();
+    if (m_mode == T8NCallMode::File)
+        writeFile(m_allocPath.string(), m_allocPathContent);
+    else
+        m_allocData = preState;
 }
 
 void BlockMining::prepareTxnFile()
@@ -177,14 +218,18 @@ void BlockMining::prepareTxnFile()
         dev::RLPStream txsout(m_currentBlockRef.transactions().size());
         for (auto const& tr : m_currentBlockRef.transactions())
             txsout.appendRaw(tr->asRLPStream().out());
+        string const txsRlp = dev::toString(txsout.out());
         m_txsPathContent =  "\"";
-        m_txsPathContent += dev::toString(txsout.out());
+        m_txsPathContent += txsRlp;
         m_txsPathContent += "\"";
-        writeFile(m_txsPath.string(), m_txsPathContent);
+        if (m_mode == T8NCallMode::File)
+            writeFile(m_txsPath.string(), m_txsPathContent);
+        else
+            m_txsData = spDataObject(new DataObject(txsRlp));
     }
     else
     {
-        DataObject txs(DataType::Array);
+        spDataObject txs(new DataObject(DataType::Array));
         static u256 c_maxGasLimit = u256("0xffffffffffffffff");
         for (auto const& tr : m_currentBlockRef.transactions())
         {
@@ -193,63 +238,88 @@ void BlockMining::prepareTxnFile()
                 auto trData = tr->asDataObject(ExportOrder::ToolStyle);
                 (*trData)["hash"] = tr->hash().asString();
                 (*trData)["sender"] = tr->sender().asString();
-                txs.addArrayObject(trData);
+                (*txs).addArrayObject(trData);
             }
             else
                 ETH_WARNING("Retesteth rejecting tx with gasLimit > 64 bits for tool" +
                             TestOutputHelper::get().testInfo().errorDebug());
         }
-        Options::getCurrentConfig().performFieldReplace(txs, FieldReplaceDir::RetestethToClient);
-        m_txsPathContent = txs.asJson();
-        writeFile(m_txsPath.string(), m_txsPathContent);
+        Options::getCurrentConfig().performFieldReplace(txs.getContent(), FieldReplaceDir::RetestethToClient);
+        if (m_serializeInputs)
+            m_txsPathContent = txs->asJson();
+        if (m_mode == T8NCallMode::File)
+            writeFile(m_txsPath.string(), m_txsPathContent);
+        else
+            m_txsData = txs;
     }
 }
 
-void BlockMining::executeTransition()
+void BlockMining::prepareToolArgs()
 {
-    m_outPath = m_chainRef.tmpDir() / "out.json";
-    m_outAllocPath = m_chainRef.tmpDir() / "outAlloc.json";
-    m_outErrorPath = m_chainRef.tmpDir() / "error.json";
-
-    m_cmd = m_chainRef.toolPath().string();
-
     // Convert FrontierToHomesteadAt5 -> Homestead if block > 5, and get reward
     auto tupleRewardFork = prepareReward(m_engine, m_chainRef.fork(), m_currentBlockRef);
-    m_cmd += " --state.fork " + std::get<1>(tupleRewardFork).asString();
+    m_args.clear();
+    m_args.emplace_back("--state.fork");
+    m_args.emplace_back(std::get<1>(tupleRewardFork).asString());
 
+    m_args.emplace_back("--state.reward");
     if (m_engine == SealEngine::NoReward)
-        m_cmd += " --state.reward 0";
+        m_args.emplace_back("0");
     else
     {
         if (m_engine == SealEngine::Genesis)
-            m_cmd += " --state.reward -1";
+            m_args.emplace_back("-1");
         else
-            m_cmd += " --state.reward " + std::get<0>(tupleRewardFork).asDecString();
+            m_args.emplace_back(std::get<0>(tupleRewardFork).asDecString());
     }
 
     auto const& params = m_chainRef.params().getCContent().params();
     if (params.count("chainID"))
-        m_cmd += " --state.chainid " + VALUE(params.atKey("chainID")).asDecString();
-
-    m_cmd += " --input.alloc " + m_allocPath.string();
-    m_cmd += " --input.txs " + m_txsPath.string();
-    m_cmd += " --input.env " + m_envPath.string();
-    m_cmd += " --output.basedir " + m_chainRef.tmpDir().string();
-    m_cmd += " --output.result " + m_outPath.filename().string();
-    m_cmd += " --output.alloc " + m_outAllocPath.filename().string();
-    m_cmd += " --output.errorlog " + m_outErrorPath.string();
+    {
+        m_args.emplace_back("--state.chainid");
+        m_args.emplace_back(VALUE(params.atKey("chainID")).asDecString());
+    }
 
     bool traceCondition = Options::get().vmtrace && m_currentBlockRef.header()->number() != 0;
     if (traceCondition)
     {
-        m_cmd += " --trace ";
+        m_args.emplace_back("--trace");
         if (!Options::get().vmtrace_nomemory)
-            m_cmd += "--trace.memory ";
+            m_args.emplace_back("--trace.memory");
         if (!Options::get().vmtrace_noreturndata)
-            m_cmd += "--trace.returndata ";
+            m_args.emplace_back("--trace.returndata");
         if (Options::get().vmtrace_nostack)
-            m_cmd += "--trace.nostack ";
+            m_args.emplace_back("--trace.nostack");
+
+        // Trace files are written to the basedir, which is only created by writing input files
+        if (m_mode != T8NCallMode::File)
+            fs::create_directories(m_chainRef.tmpDir());
     }
+}
+
+std::vector<std::string> const& BlockMining::stdioArgs() const
+{
+    static std::vector<std::string> const args = {"--input.alloc", "stdin", "--input.txs", "stdin",
+        "--input.env", "stdin", "--output.result", "stdout", "--output.alloc", "stdout"};
+    return args;
+}
+
+spDataObject BlockMining::makeStdinInput() const
+{
+    spDataObject input;
+    if (m_allocRef.empty())
+        (*input).addSubObject("alloc", m_allocData);
+    else
+        (*input)["allocRef"] = m_allocRef;
+    (*input).addSubObject("env", m_envData);
+    bool const exportRLP = m_txsData->type() == DataType::String;
+    (*input).addSubObject(exportRLP ? "txsRlp" : "txs", m_txsData);
+    return input;
+}
+
+void BlockMining::executeTransition()
+{
+    prepareToolArgs();
 
     ETH_DC_MESSAGE(DC::RPC, "Alloc:\n" + m_allocPathContent);
     if (m_currentBlockRef.transactions().size())
@@ -261,10 +331,38 @@ void BlockMining::executeTransition()
     }
     ETH_DC_MESSAGE(DC::RPC, "Env:\n" + m_envPathContent);
 
+    switch (m_mode)
+    {
+    case T8NCallMode::Daemon: executeTransitionOnDaemon(); break;
+    case T8NCallMode::Stdio: executeTransitionOnStdio(); break;
+    default: executeTransitionOnTool();
+    }
+}
+
+void BlockMining::executeTransitionOnTool()
+{
+    m_outPath = m_chainRef.tmpDir() / "out.json";
+    m_outAllocPath = m_chainRef.tmpDir() / "outAlloc.json";
+    m_outErrorPath = m_chainRef.tmpDir() / "error.json";
+
+    m_cmd = m_chainRef.toolPath().string();
+    for (auto const& arg : m_args)
+        m_cmd += " " + arg;
+
+    m_cmd += " --input.alloc " + m_allocPath.string();
+    m_cmd += " --input.txs " + m_txsPath.string();
+    m_cmd += " --input.env " + m_envPath.string();
+    m_cmd += " --output.basedir " + m_chainRef.tmpDir().string();
+    m_cmd += " --output.result " + m_outPath.filename().string();
+    m_cmd += " --output.alloc " + m_outAllocPath.filename().string();
+    m_cmd += " --output.errorlog " + m_outErrorPath.string();
+
     int exitcode;
-    TestOutputHelper::get().timer().startSubcallTimer();
-    string out = test::executeCmd(m_cmd, exitcode, ExecCMDWarning::NoWarningNoError);
-    TestOutputHelper::get().timer().finishSubcallTimer();
+    string out;
+    {
+        ProfileScope profile(ProfilePhase::ToolExecution);
+        out = test::executeCmd(m_cmd, exitcode, ExecCMDWarning::NoWarningNoError);
+    }
     ETH_DC_MESSAGE(DC::RPC, m_cmd);
     if (exitcode != 0)
     {
@@ -275,29 +373,149 @@ void BlockMining::executeTransition()
     ETH_DC_MESSAGE(DC::RPC, out);
 }
 
-ToolResponse BlockMining::readResult()
+void BlockMining::executeTransitionOnStdio()
 {
-    const string outPathContent = dev::contentsString(m_outPath.string());
-    const string outAllocPathContent = dev::contentsString(m_outAllocPath.string());
-    ETH_DC_MESSAGE(DC::RPC, "Res:\n" + outPathContent);
-    ETH_DC_MESSAGE(DC::RPC, "RAlloc:\n" + outAllocPathContent);
-    ETH_DC_MESSAGEC(DC::RPC, "Tool log: \n" + dev::contentsString(m_outErrorPath.string()), LogColor::YELLOW);
+    m_cmd = m_chainRef.toolPath().string();
+    for (auto const& arg : m_args)
+        m_cmd += " " + arg;
+    for (auto const& arg : stdioArgs())
+        m_cmd += " " + arg;
+    m_cmd += " --output.basedir " + m_chainRef.tmpDir().string();
 
-    if (outPathContent.empty())
+    int exitcode;
+    string errorContent;
+    string const input = makeStdinInput()->asJson(0, false);
+    string out;
     {
-        const string outErrorContent = dev::contentsString(m_outErrorPath.string());
-        ETH_ERROR_MESSAGE("Tool returned empty file: " + m_outPath.string() + "\n" + outErrorContent);
+        ProfileScope profile(ProfilePhase::ToolExecution);
+        out = test::executeCmdStdio(m_cmd, input, exitcode, errorContent);
     }
-    if (outAllocPathContent.empty())
+    ETH_DC_MESSAGE(DC::RPC, m_cmd);
+    if (exitcode != 0)
     {
-        const string outErrorContent = dev::contentsString(m_outErrorPath.string());
-        ETH_ERROR_MESSAGE("Tool returned empty file: " + m_outAllocPath.string() + "\n" + outErrorContent);
+        ETH_DC_MESSAGE(DC::RPC, "Tool Error:\n" + errorContent);
+        throw test::UpwardsException(errorContent.empty() ? (out.empty() ? "Tool failed: " + m_cmd : out) : errorContent);
+    }
+    ETH_DC_MESSAGEC(DC::RPC, "Tool log: \n" + errorContent, LogColor::YELLOW);
+    if (out.empty())
+        ETH_ERROR_MESSAGE("Tool returned empty stdout: " + m_cmd + "\n" + errorContent);
+    m_toolOutput = ConvertJsoncppStringToData(out);
+}
+
+void BlockMining::executeTransitionOnDaemon()
+{
+    spDataObject request;
+    for (auto const& arg : m_args)
+        (*request)["args"].addArrayObject(spDataObject(new DataObject(arg)));
+    for (auto const& arg : stdioArgs())
+        (*request)["args"].addArrayObject(spDataObject(new DataObject(arg)));
+    (*request)["args"].addArrayObject(spDataObject(new DataObject("--output.basedir")));
+    (*request)["args"].addArrayObject(spDataObject(new DataObject(m_chainRef.tmpDir().string())));
+    (*request).addSubObject("input", makeStdinInput());
+    if (m_allocDiff)
+        (*request)["outputAllocDiff"] = true;
+
+    spT8NDaemon daemon = m_chainRef.t8nDaemon();
+    m_cmd = daemon->path().string() + " " + request->atKey("args").asJson(0, false);
+    ETH_DC_MESSAGE(DC::RPC, m_cmd);
+
+    string response;
+    string const input = request->asJson(0, false);
+    try
+    {
+        ProfileScope profile(ProfilePhase::ToolExecution);
+        response = daemon.getContent().request(input);
+    }
+    catch (test::UpwardsException const& _ex)
+    {
+        if (!daemon->timedOut())
+            throw;
+
+        // The daemon is stopped, run the tool for each block from now on
+        ETH_WARNING(string(_ex.what()) + ", calling the tool for each block");
+        m_mode = T8NCallMode::Stdio;
+        m_allocDiff = false;
+        if (!m_allocRef.empty())
+        {
+            m_allocRef.clear();
+            m_allocData = m_currentBlockRef.state()->asDataObject();
+        }
+        executeTransitionOnStdio();
+        return;
     }
 
+    spDataObject daemonResponse = ConvertJsoncppStringToData(response);
+    if (!m_allocRef.empty() && daemonResponse->count("unknownAllocRef"))
+    {
+        // Daemon no longer has the parent post state, send it in full
+        ETH_DC_MESSAGE(DC::RPC, "T8N daemon does not know allocRef " + m_allocRef + ", sending full alloc");
+        m_allocRef.clear();
+        m_allocData = m_currentBlockRef.state()->asDataObject();
+        executeTransitionOnDaemon();
+        return;
+    }
+    string const errorContent = daemonResponse->count("error") ? daemonResponse->atKey("error").asString() : string();
+    int const exitcode = daemonResponse->count("exitCode") ? daemonResponse->atKey("exitCode").asInt() : 1;
+    if (exitcode != 0 || !daemonResponse->count("output"))
+    {
+        ETH_DC_MESSAGE(DC::RPC, "Tool Error:\n" + errorContent);
+        throw test::UpwardsException(errorContent.empty() ? "Tool failed: " + m_cmd + "\n" + response : errorContent);
+    }
+    ETH_DC_MESSAGEC(DC::RPC, "Tool log: \n" + errorContent, LogColor::YELLOW);
+    m_toolOutput = (*daemonResponse).atKeyPointerUnsafe("output");
+}
+
+ToolResponse BlockMining::readResult()
+{
+    spDataObject result;
+    spDataObject returnState;
+    if (m_mode != T8NCallMode::File)
+    {
+        DataObject& output = m_toolOutput.getContent();
+        bool const hasDiff = m_allocDiff && output.count("allocDiff");
+        if (!output.count("result") || (!output.count("alloc") && !hasDiff))
+            ETH_ERROR_MESSAGE("Tool returned incomplete output: \n" + output.asJson());
+        result = output.atKeyPointerUnsafe("result");
+        ETH_DC_MESSAGE(DC::RPC, "Res:\n" + result->asJson());
+        if (hasDiff)
+        {
+            DataObject& allocDiff = output.atKeyUnsafe("allocDiff");
+            ETH_DC_MESSAGE(DC::RPC, "RAllocDiff:\n" + allocDiff.asJson());
+            return makeToolResponse(result, restoreStateFromDiff(m_currentBlockRef.state(), allocDiff));
+        }
+        returnState = output.atKeyPointerUnsafe("alloc");
+        ETH_DC_MESSAGE(DC::RPC, "RAlloc:\n" + returnState->asJson());
+    }
+    else
+    {
+        const string outPathContent = dev::contentsString(m_outPath.string());
+        const string outAllocPathContent = dev::contentsString(m_outAllocPath.string());
+        ETH_DC_MESSAGE(DC::RPC, "Res:\n" + outPathContent);
+        ETH_DC_MESSAGE(DC::RPC, "RAlloc:\n" + outAllocPathContent);
+        ETH_DC_MESSAGEC(DC::RPC, "Tool log: \n" + dev::contentsString(m_outErrorPath.string()), LogColor::YELLOW);
+
+        if (outPathContent.empty())
+        {
+            const string outErrorContent = dev::contentsString(m_outErrorPath.string());
+            ETH_ERROR_MESSAGE("Tool returned empty file: " + m_outPath.string() + "\n" + outErrorContent);
+        }
+        if (outAllocPathContent.empty())
+        {
+            const string outErrorContent = dev::contentsString(m_outErrorPath.string());
+            ETH_ERROR_MESSAGE("Tool returned empty file: " + m_outAllocPath.string() + "\n" + outErrorContent);
+        }
+        result = ConvertJsoncppStringToData(outPathContent);
+        returnState = ConvertJsoncppStringToData(outAllocPathContent);
+    }
+
+    return makeToolResponse(result, restoreStateOverlay(m_currentBlockRef.state(), returnState.getContent()));
+}
+
+ToolResponse BlockMining::makeToolResponse(spDataObject const& _result, spState const& _postState)
+{
     // Construct block rpc response
-    ToolResponse toolResponse(ConvertJsoncppStringToData(outPathContent));
-    spDataObject returnState = ConvertJsoncppStringToData(outAllocPathContent);
-    toolResponse.attachState(restoreFullState(returnState.getContent()));
+    ToolResponse toolResponse(_result.getCContent());
+    toolResponse.attachState(_postState);
 
     const bool traceCondition = Options::get().vmtrace && m_currentBlockRef.header()->number() != 0;
     if (traceCondition)
@@ -355,12 +573,15 @@ BlockMining::~BlockMining()
         dev::writeFile(cmdFile, dev::asBytes(m_cmd));
     }
 
-    fs::remove(m_envPath);
-    fs::remove(m_allocPath);
-    fs::remove(m_outErrorPath);
-    fs::remove(m_txsPath);
-    fs::remove(m_outPath);
-    fs::remove(m_outAllocPath);
+    if (m_mode == T8NCallMode::File)
+    {
+        fs::remove(m_envPath);
+        fs::remove(m_allocPath);
+        fs::remove(m_outErrorPath);
+        fs::remove(m_txsPath);
+        fs::remove(m_outPath);
+        fs::remove(m_outAllocPath);
+    }
     fs::remove_all(m_chainRef.tmpDir());
 }
 
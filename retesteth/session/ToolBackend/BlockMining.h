@@ -12,9 +12,7 @@ class BlockMining
 {
 public:
     BlockMining(ToolChain const& _toolChain, EthereumBlockState const& _currentBlock, EthereumBlockState const& _parentBlock,
-        SealEngine _engine)
-      : m_chainRef(_toolChain), m_currentBlockRef(_currentBlock), m_parentBlockRef(_parentBlock), m_engine(_engine)
-    {}
+        SealEngine _engine);
     ~BlockMining();
 
     void prepareEnvFile();
@@ -29,6 +27,17 @@ private:
     EthereumBlockState const& m_parentBlockRef;
     SealEngine m_engine;
 
+    // How inputs and outputs are passed to the t8n tool
+    enum class T8NCallMode
+    {
+        File,
+        Stdio,
+        Daemon
+    };
+    T8NCallMode m_mode;
+    bool m_serializeInputs;
+    bool m_allocDiff;
+
 private:
     boost::filesystem::path m_allocPath;
     std::string m_allocPathContent;
@@ -40,6 +49,22 @@ private:
     boost::filesystem::path m_outAllocPath;
     boost::filesystem::path m_outErrorPath;
     std::string m_cmd;
+    std::vector<std::string> m_args;
+
+    // Inputs and output of the t8n call in memory modes
+    spDataObject m_envData;
+    spDataObject m_allocData;
+    spDataObject m_txsData;
+    spDataObject m_toolOutput;
+    std::string m_allocRef;
+
+    void prepareToolArgs();
+    std::vector<std::string> const& stdioArgs() const;
+    spDataObject makeStdinInput() const;
+    void executeTransitionOnTool();
+    void executeTransitionOnStdio();
+    void executeTransitionOnDaemon();
+    ToolResponse makeToolResponse(spDataObject const& _result, spState const& _postState);
     void traceTransactions(ToolResponse& _toolResponse);
 };
 }  // namespace toolimpl
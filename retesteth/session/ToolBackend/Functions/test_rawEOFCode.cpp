@@ -34,3 +34,12 @@ string ToolChainManager::test_rawEOFCode(
     }
     return response;
 }
+
+string ToolChainManager::test_rawEOFCode(BYTES const& _code, T8NDaemon& _process)
+{
+    // The tool answers each hex line with `OK ..` or `err: <reason>`
+    ETH_DC_MESSAGE(DC::RPC, "eof stdin: " + _code.asString());
+    string const response = _process.request(_code.asString());
+    ETH_DC_MESSAGE(DC::RPC, "Response: " + response);
+    return response;
+}
@@ -5,6 +5,7 @@
 #include <retesteth/EthChecks.h>
 #include <retesteth/helpers/TestHelper.h>
 #include <libdevcore/CommonIO.h>
+#include <libdevcore/RLP.h>
 #include <libdevcore/SHA3.h>
 using namespace std;
 using namespace dev;
@@ -14,13 +15,71 @@ using namespace toolimpl;
 using namespace test::session;
 namespace fs = boost::filesystem;
 
-TestRawTransaction ToolChainManager::test_rawTransaction(
-    BYTES const& _rlp, FORK const& _fork, fs::path const& _toolPath, fs::path const& _tmpDir)
+namespace
+{
+// Construct test_rawTransaction response from the t9n result of one transaction
+// Sets _hashMismatch if t9n returned a different transaction hash than retesteth
+spDataObject makeRawTransactionResponse(DataObject const& _resTr, BYTES const& _rlp, bool _rejected, string& _hashMismatch)
 {
     // Prepare test_mineBlocks response structure
-    DataObject out;
-    out["result"] = true;
+    spDataObject out;
+    (*out)["result"] = true;
+
+    string const hash = "0x" + dev::toString(dev::sha3(fromHex(_rlp.asString())));
+    spDataObject tr;
+    if (_resTr.count("intrinsicGas"))
+    {
+        if (_resTr.atKey("intrinsicGas").type() == DataType::Integer)
+            (*tr)["intrinsicGas"] = VALUE(_resTr.atKey("intrinsicGas").asInt()).asString();
+        else if (_resTr.atKey("intrinsicGas").type() == DataType::String)
+            (*tr)["intrinsicGas"] = VALUE(_resTr.atKey("intrinsicGas").asString()).asString();
+        else
+            ETH_ERROR_MESSAGE("`intrinsicGas` field type expected to be Int or String: `" + _resTr.asJson());
+    }
+    else
+        (*tr)["intrinsicGas"] = "0x00";
+
+    if (_rejected)
+    {
+        (*tr)["error"] = _resTr.atKey("error").asString();
+        (*tr)["sender"] = FH20::zero().asString();
+        (*tr)["hash"] = hash;
+        (*out)["rejectedTransactions"].addArrayObject(tr);
+    }
+    else
+    {
+        (*tr)["sender"] = _resTr.atKey("address").asString();
+        (*tr)["hash"] = _resTr.atKey("hash").asString();
+        (*out)["acceptedTransactions"].addArrayObject(tr);
+        if (tr->atKey("hash").asString() != hash)
+            _hashMismatch = "t8n tool returned different tx.hash than retesteth: (t8n.hash != retesteth.hash) " +
+                            tr->atKey("hash").asString() + " != " + hash;
+    }
+    return out;
+}
+
+// Typed transactions are wrapped as RLP strings, legacy ones go as is and must be exactly one RLP list
+// otherwise the tool would split the transactions of a batch at wrong positions
+bool canBatchTransaction(BYTES const& _rlp)
+{
+    if (_rlp.firstByte() < 128)
+        return true;
+    try
+    {
+        bytes const data = fromHex(_rlp.asString());
+        RLP const rlp(data, RLP::VeryStrict);
+        return rlp.isList() && rlp.actualSize() == data.size();
+    }
+    catch (std::exception const&)
+    {
+        return false;
+    }
+}
+}  // namespace
 
+TestRawTransaction ToolChainManager::test_rawTransaction(
+    BYTES const& _rlp, FORK const& _fork, fs::path const& _toolPath, fs::path const& _tmpDir)
+{
     // Prepare transaction file
     fs::path const txsPath = _tmpDir / "tx.rlp";
     fs::path const errorLog = _tmpDir / "error.txt";
@@ -76,38 +135,80 @@ TestRawTransaction ToolChainManager::test_rawTransaction(
             throw _ex;
     }
 
-    string const hash = "0x" + dev::toString(dev::sha3(fromHex(_rlp.asString())));
-    spDataObject tr;
+    bool const rejected = response.find("error") != string::npos || response.find("ERROR") != string::npos || errorCaught;
+    string hashMismatch;
+    spDataObject const out = makeRawTransactionResponse(res->getSubObjects().at(0).getCContent(), _rlp, rejected, hashMismatch);
+    if (!hashMismatch.empty())
+        ETH_ERROR_MESSAGE(hashMismatch);
+
+    ETH_DC_MESSAGE(DC::RPC, "Response: test_rawTransaction `" + out->asJson());
+    return TestRawTransaction(out.getCContent());
+}
+
+std::vector<TestRawTransaction> ToolChainManager::test_rawTransactions(
+    std::vector<BYTES> const& _rlps, FORK const& _fork, fs::path const& _toolPath, fs::path const& _tmpDir)
+{
+    std::vector<TestRawTransaction> results;
+    if (_rlps.empty())
+        return results;
+    for (auto const& rlp : _rlps)
+        if (!canBatchTransaction(rlp))
+            return results;
+
+    fs::path const txsPath = _tmpDir / "txs.rlp";
+    fs::path const errorLog = _tmpDir / "error.txt";
 
-    auto const& resTr = res->getSubObjects().at(0);
-    if (resTr->count("intrinsicGas"))
+    RLPStream txsout(_rlps.size());
+    for (auto const& rlp : _rlps)
     {
-        if (resTr->atKey("intrinsicGas").type() == DataType::Integer)
-            (*tr)["intrinsicGas"] = VALUE(resTr->atKey("intrinsicGas").asInt()).asString();
-        else if (resTr->atKey("intrinsicGas").type() == DataType::String)
-            (*tr)["intrinsicGas"] = VALUE(resTr->atKey("intrinsicGas").asString()).asString();
+        bytes const data = fromHex(rlp.asString());
+        if (rlp.firstByte() < 128)
+            txsout.append(data);
         else
-            ETH_ERROR_MESSAGE("`intrinsicGas` field type expected to be Int or String: `" + resTr->asJson());
+            txsout.appendRaw(data, 1);
     }
-    else
-        (*tr)["intrinsicGas"] = "0x00";
+    string const txsContent = "\"" + toHexPrefixed(txsout.out()) + "\"";
+    writeFile(txsPath.string(), txsContent);
+    ETH_DC_MESSAGE(DC::RPC, "TXS file:\n" + txsContent);
+
+    string cmd = _toolPath.string();
+    cmd += " --input.txs " + txsPath.string();
+    cmd += " --state.fork " + _fork.asString();
+    cmd += " --output.errorlog " + errorLog.string();
 
-    if (response.find("error") != string::npos || response.find("ERROR") != string::npos || errorCaught)
+    ETH_DC_MESSAGE(DC::RPC, cmd);
+    int exitCode;
+    string const response = test::executeCmd(cmd, exitCode, ExecCMDWarning::NoWarningNoError);
+    ETH_DC_MESSAGE(DC::RPC, "T9N Response:\n" + response);
+
+    // Anything unexpected means the transactions have to be validated one by one
+    spDataObject res;
+    try
     {
-        (*tr)["error"] = resTr->atKey("error").asString();
-        (*tr)["sender"] = FH20::zero().asString();
-        (*tr)["hash"] = hash;
-        out["rejectedTransactions"].addArrayObject(tr);
+        res = dataobject::ConvertJsoncppStringToData(response);
     }
-    else
+    catch (std::exception const&)
     {
-        (*tr)["sender"] = resTr->atKey("address").asString();
-        (*tr)["hash"] = resTr->atKey("hash").asString();
-        out["acceptedTransactions"].addArrayObject(tr);
-        if (tr->atKey("hash").asString() != hash)
-            ETH_ERROR_MESSAGE("t8n tool returned different tx.hash than retesteth: (t8n.hash != retesteth.hash) " + tr->atKey("hash").asString() + " != " + hash);
+        return results;
     }
+    if (exitCode != 0 || res->type() != DataType::Array || res->getSubObjects().size() != _rlps.size())
+        return results;
 
-    ETH_DC_MESSAGE(DC::RPC, "Response: test_rawTransaction `" + out.asJson());
-    return TestRawTransaction(out);
+    for (size_t i = 0; i < _rlps.size(); i++)
+    {
+        DataObject const& resTr = res->getSubObjects().at(i).getCContent();
+        if (resTr.count("intrinsicGas") && resTr.atKey("intrinsicGas").type() != DataType::Integer &&
+            resTr.atKey("intrinsicGas").type() != DataType::String)
+            return std::vector<TestRawTransaction>();
+        string hashMismatch;
+        spDataObject const out = makeRawTransactionResponse(resTr, _rlps.at(i), resTr.count("error"), hashMismatch);
+        if (!hashMismatch.empty())
+        {
+            ETH_DC_MESSAGE(DC::RPC, "T9N batch result mismatch: " + hashMismatch);
+            return std::vector<TestRawTransaction>();
+        }
+        results.emplace_back(TestRawTransaction(out.getCContent()));
+    }
+    ETH_DC_MESSAGE(DC::RPC, "Response: test_rawTransactions " + test::fto_string(results.size()) + " transactions");
+    return results;
 }
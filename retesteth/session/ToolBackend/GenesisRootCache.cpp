@@ -0,0 +1,102 @@
+#include "GenesisRootCache.h"
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/SHA3.h>
+#include <retesteth/EthChecks.h>
+#include <retesteth/Options.h>
+#include <retesteth/helpers/TestHelper.h>
+
+using namespace std;
+using namespace dataobject;
+using namespace test;
+using namespace test::debug;
+namespace fs = boost::filesystem;
+
+namespace toolimpl
+{
+GenesisRootCache& GenesisRootCache::get()
+{
+    static GenesisRootCache instance;
+    return instance;
+}
+
+GenesisRootCache::GenesisRootCache()
+  : m_file(cacheDataDir() / "genesisroots.json", "genesis root cache"), m_enabled(Options::get().genesisrootcache)
+{
+    if (!m_enabled)
+        return;
+    spDataObject const roots = m_file.load();
+    for (auto const& el : roots->getSubObjects())
+    {
+        try
+        {
+            m_roots[el->getKey()] = FH32(el->asString()).asString();
+        }
+        catch (std::exception const&)
+        {
+            // A broken entry is calculated again
+        }
+    }
+}
+
+string GenesisRootCache::makeKey(State const& _state, string const& _toolIdentity)
+{
+    // Accounts and storage are ordered maps, so the json of equal states is the same
+    // The state root does not depend on the fork, so the fork is not a part of the key
+    string const content = _toolIdentity + "\n" + _state.asDataObject()->asJson(0, false);
+    return dev::sha3(content).hex();
+}
+
+string GenesisRootCache::toolIdentity(fs::path const& _toolPath)
+{
+    if (!m_enabled)
+        return _toolPath.string();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto const identity = m_toolIdentities.find(_toolPath.string());
+        if (identity != m_toolIdentities.end())
+            return identity->second;
+    }
+
+    // The tool is often a script calling the client binary, whose update only the version output shows
+    int exitCode;
+    string const version = test::executeCmd(_toolPath.string() + " -v", exitCode, ExecCMDWarning::NoWarningNoError);
+    string const identity =
+        _toolPath.string() + "\n" + dev::sha3(dev::contentsString(_toolPath.string())).hex() + "\n" + version;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_toolIdentities.emplace(_toolPath.string(), identity);
+    return identity;
+}
+
+bool GenesisRootCache::find(string const& _key, FH32& _root)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto const root = m_roots.find(_key);
+    if (root == m_roots.end())
+        return false;
+    _root = FH32(root->second);
+    ETH_DC_MESSAGE(DC::RPC, "Genesis state root from cache: " + root->second);
+    return true;
+}
+
+void GenesisRootCache::record(string const& _key, FH32 const& _root)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_roots[_key] = _root.asString();
+    m_recorded.emplace(_key);
+}
+
+void GenesisRootCache::save()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_enabled || m_recorded.empty())
+        return;
+
+    DataObject roots(DataType::Object);
+    for (auto const& key : m_recorded)
+        roots[key] = m_roots.at(key);
+    if (m_file.save(roots))
+        m_recorded.clear();
+}
+
+}  // namespace toolimpl
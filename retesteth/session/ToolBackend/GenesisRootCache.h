@@ -0,0 +1,43 @@
+#pragma once
+#include <retesteth/helpers/PersistentCache.h>
+#include <retesteth/testStructures/types/Ethereum/State.h>
+#include <boost/filesystem/path.hpp>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace toolimpl
+{
+using namespace test::teststruct;
+
+// Genesis state roots by pre state content, shared by all forks and tests of the run
+// With --genesisrootcache the roots are kept in `<datadir>/genesisroots.json` for the next runs
+class GenesisRootCache
+{
+public:
+    static GenesisRootCache& get();
+
+    // Hash of the pre state and the identity of the tool that calculated the root
+    static std::string makeKey(State const& _state, std::string const& _toolIdentity);
+
+    // Path, content hash and `-v` output of the tool, so the roots of a rebuilt tool are not taken from the file
+    // Just the path if the roots are not kept between runs
+    std::string toolIdentity(boost::filesystem::path const& _toolPath);
+
+    bool find(std::string const& _key, FH32& _root);
+    void record(std::string const& _key, FH32 const& _root);
+    void save();
+
+private:
+    GenesisRootCache();
+
+    std::mutex m_mutex;
+    std::map<std::string, std::string> m_roots;
+    std::set<std::string> m_recorded;
+    std::map<std::string, std::string> m_toolIdentities;
+    test::PersistentCacheFile m_file;
+    bool m_enabled = false;
+};
+
+}  // namespace toolimpl
@@ -0,0 +1,185 @@
+#include "T8NDaemon.h"
+#include <retesteth/EthChecks.h>
+#include <retesteth/Options.h>
+#include <chrono>
+#include <limits>
+#include <thread>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace test;
+using namespace test::debug;
+namespace fs = boost::filesystem;
+
+namespace
+{
+auto const c_stopGracePeriod = chrono::seconds(2);
+}  // namespace
+
+namespace toolimpl
+{
+T8NDaemon::T8NDaemon(fs::path const& _daemonPath, size_t _timeout, vector<string> const& _args)
+  : m_daemonPath(_daemonPath), m_args(_args), m_timeout(_timeout)
+{
+    start();
+}
+
+T8NDaemon::~T8NDaemon()
+{
+    stop();
+}
+
+void T8NDaemon::start()
+{
+    int sockets[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sockets) == -1)
+        throw test::UpwardsException("T8NDaemon: failed to create socketpair for `" + m_daemonPath.string() + "`");
+
+    bool const enableOutput = Options::get().enableClientsOutput;
+    string const path = m_daemonPath.string();
+    vector<char*> argv;
+    argv.push_back(const_cast<char*>(path.c_str()));
+    for (auto const& arg : m_args)
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    argv.push_back(nullptr);
+    pid_t const pid = fork();
+    if (pid == -1)
+    {
+        close(sockets[0]);
+        close(sockets[1]);
+        throw test::UpwardsException("T8NDaemon: fork failed for `" + path + "`");
+    }
+
+    // child process, the daemon talks to us over its stdin/stdout
+    if (pid == 0)
+    {
+        close(sockets[0]);
+        dup2(sockets[1], STDIN_FILENO);
+        dup2(sockets[1], STDOUT_FILENO);
+        close(sockets[1]);
+        if (!enableOutput)
+        {
+            int const fdo = open("/dev/null", O_WRONLY);
+            if (fdo != -1)
+            {
+                dup2(fdo, STDERR_FILENO);
+                close(fdo);
+            }
+        }
+        execv(path.c_str(), argv.data());
+        _exit(127);
+    }
+
+    close(sockets[1]);
+    m_socket = sockets[0];
+    m_pid = pid;
+    m_readBuffer.clear();
+    ETH_DC_MESSAGE(DC::RPC, "T8NDaemon started `" + path + "` pid: " + to_string(m_pid));
+}
+
+void T8NDaemon::stop()
+{
+    if (m_socket != -1)
+    {
+        close(m_socket);
+        m_socket = -1;
+    }
+    if (m_pid > 0)
+    {
+        // A daemon that timed out or ignores SIGTERM for the grace period is killed
+        bool reaped = false;
+        if (!m_timedOut)
+        {
+            kill(m_pid, SIGTERM);
+            auto const deadline = chrono::steady_clock::now() + c_stopGracePeriod;
+            while (!(reaped = waitpid(m_pid, NULL, WNOHANG) != 0) && chrono::steady_clock::now() < deadline)
+                this_thread::sleep_for(chrono::milliseconds(10));
+        }
+        if (!reaped)
+        {
+            kill(m_pid, SIGKILL);
+            while (waitpid(m_pid, NULL, 0) == -1 && errno == EINTR)
+                continue;
+        }
+        m_pid = 0;
+    }
+}
+
+bool T8NDaemon::readLine(string& _line)
+{
+    char buf[65536];
+    auto const deadline = chrono::steady_clock::now() + chrono::seconds(m_timeout);
+    size_t pos = m_readBuffer.find('\n');
+    while (pos == string::npos)
+    {
+        auto const left = chrono::duration_cast<chrono::milliseconds>(deadline - chrono::steady_clock::now()).count();
+        pollfd pfd = {m_socket, POLLIN, 0};
+        int const ready = left > 0 ? poll(&pfd, 1, (int)std::min<int64_t>(left, std::numeric_limits<int>::max())) : 0;
+        if (ready == -1 && errno == EINTR)
+            continue;
+        if (ready == 0)
+        {
+            m_timedOut = true;
+            return false;
+        }
+        if (ready == -1)
+            return false;
+
+        ssize_t const ret = recv(m_socket, buf, sizeof(buf), 0);
+        if (ret == -1 && errno == EINTR)
+            continue;
+        if (ret <= 0)
+            return false;
+        size_t const offset = m_readBuffer.size();
+        m_readBuffer.append(buf, ret);
+        pos = m_readBuffer.find('\n', offset);
+    }
+    _line = m_readBuffer.substr(0, pos);
+    m_readBuffer.erase(0, pos + 1);
+    return true;
+}
+
+string T8NDaemon::request(string const& _request)
+{
+    if (m_timedOut)
+        throw test::UpwardsException("T8NDaemon: `" + m_daemonPath.string() + "` timed out before");
+    if (m_pid > 0 && waitpid(m_pid, NULL, WNOHANG) != 0)
+    {
+        ETH_DC_MESSAGE(DC::RPC, "T8NDaemon `" + m_daemonPath.string() + "` has exited, restarting");
+        m_pid = 0;
+        stop();
+    }
+    if (m_pid == 0)
+        start();
+
+    string const req = _request + "\n";
+    size_t sent = 0;
+    while (sent < req.size())
+    {
+        ssize_t const ret = send(m_socket, req.c_str() + sent, req.size() - sent, MSG_NOSIGNAL);
+        if (ret <= 0)
+        {
+            stop();
+            throw test::UpwardsException("T8NDaemon: writing request to `" + m_daemonPath.string() + "` failed");
+        }
+        sent += ret;
+    }
+
+    string response;
+    if (!readLine(response))
+    {
+        stop();
+        if (m_timedOut)
+            throw test::UpwardsException("T8NDaemon: `" + m_daemonPath.string() + "` did not respond within " +
+                                         to_string(m_timeout) + " seconds (`t8nDaemonTimeout`)");
+        throw test::UpwardsException("T8NDaemon: `" + m_daemonPath.string() + "` closed the connection without response");
+    }
+    return response;
+}
+
+}  // namespace toolimpl
@@ -0,0 +1,50 @@
+#pragma once
+#include <libdataobj/DataObject.h>
+#include <boost/filesystem/path.hpp>
+#include <string>
+#include <vector>
+
+namespace toolimpl
+{
+// Long living t8n process, started once per worker session instead of fork/exec per mined block
+// The process reads a single line json request from stdin and writes a single line json response to stdout:
+//   request:  {"args" : ["--state.fork", "Cancun", ...], "input" : {"alloc" : {}, "env" : {}, "txs" : [] | "txsRlp" : "0x.."}}
+//   response: {"exitCode" : 0, "output" : {"result" : {}, "alloc" : {}}, "error" : "tool stderr log"}
+// Input and output follow t8n `stdin` / `stdout` json format
+// With `t8nDaemonAllocDiff` client option the request may carry `"allocRef" : "<stateRoot>"` instead of `alloc`,
+// referring to a post state the daemon returned before, and `"outputAllocDiff" : true` asking for
+// `"allocDiff" : {"<address>" : account | null}` with only changed (null: deleted) accounts instead of `alloc`.
+// Daemon answers `{"unknownAllocRef" : true}` if it does not have the referred state anymore
+// The same line protocol is used to stream EOF containers to `<tool> eof` started with _args
+// A process that does not answer within _timeout seconds is stopped and not used again, requests throw from then on
+class T8NDaemon : public dataobject::GCP_SPointerBase
+{
+public:
+    T8NDaemon(boost::filesystem::path const& _daemonPath, size_t _timeout,
+        std::vector<std::string> const& _args = std::vector<std::string>());
+    ~T8NDaemon();
+
+    // Send the request line and wait for the response line. Restart the process if it died
+    std::string request(std::string const& _request);
+    boost::filesystem::path const& path() const { return m_daemonPath; }
+    int pid() const { return m_pid; }
+    bool timedOut() const { return m_timedOut; }
+
+private:
+    T8NDaemon() {}
+    void start();
+    void stop();
+    bool readLine(std::string& _line);
+
+    boost::filesystem::path m_daemonPath;
+    std::vector<std::string> m_args;
+    size_t m_timeout = 0;
+    bool m_timedOut = false;
+    int m_pid = 0;
+    int m_socket = -1;
+    std::string m_readBuffer;
+};
+
+typedef dataobject::GCP_SPointer<T8NDaemon> spT8NDaemon;
+
+}  // namespace toolimpl
@@ -1,7 +1,9 @@
 #include "BlockMining.h"
+#include "GenesisRootCache.h"
 #include "Verification.h"
 #include <Options.h>
 #include <retesteth/helpers/TestHelper.h>
+#include <retesteth/helpers/TestProfiler.h>
 #include <testStructures/Common.h>
 #include <retesteth/testSuites/Common.h>
 
@@ -27,44 +29,50 @@ void correctHeaderByToolResponse(BlockHeader& _header, ToolResponse const& _res)
 
 bool checkStatesEqual(spState _stateA, spState _stateB)
 {
-    if (_stateA->accounts().size() != _stateB->accounts().size())
+    if (_stateA->accountCount() != _stateB->accountCount())
         return false;
-    for (auto const& acc : _stateA->accounts())
-    {
-        if (!_stateB->hasAccount(acc.first))
-            return false;
-        auto const& accB = _stateB->getAccount(acc.first);
-        if (acc.second->storage().getKeys().size() != accB.storage().getKeys().size())
-            return false;
-        if (acc.second->nonce() != accB.nonce())
-            return false;
-        if (acc.second->code() != accB.code())
-            return false;
-        if (acc.second->balance() != accB.balance())
-            return false;
-        for (auto const& [str, record] : acc.second->storage().getKeys())
+    bool equal = true;
+    _stateA->forEachAccount([&](FH20 const& _address, spAccountBase const& _acc) {
+        if (!equal)
+            return;
+        if (!_stateB->hasAccount(_address))
+        {
+            equal = false;
+            return;
+        }
+        auto const& accB = _stateB->getAccount(_address);
+        if (_acc->storage().getKeys().size() != accB.storage().getKeys().size() || _acc->nonce() != accB.nonce() ||
+            _acc->code() != accB.code() || _acc->balance() != accB.balance())
+        {
+            equal = false;
+            return;
+        }
+        for (auto const& [str, record] : _acc->storage().getKeys())
         {
             auto const& keyA = std::get<0>(record);
             auto const& keyA_Value = std::get<1>(record);
-            if (!accB.storage().hasKey(keyA))
-                return false;
-            if (accB.storage().atKey(keyA) != keyA_Value)
-                return false;
+            if (!accB.storage().hasKey(keyA) || accB.storage().atKey(keyA) != keyA_Value)
+            {
+                equal = false;
+                return;
+            }
         }
-    }
-    return true;
+    });
+    return equal;
 }
 }
 
 namespace toolimpl
 {
 ToolChain::ToolChain(
-    EthereumBlockState const& _genesis, spSetChainParamsArgs const& _config, fs::path const& _toolPath, fs::path const& _tmpDir, ToolChainGenesis _genesisPolicy)
+    EthereumBlockState const& _genesis, spSetChainParamsArgs const& _config, fs::path const& _toolPath, fs::path const& _tmpDir,
+    spT8NDaemon const& _t8nDaemon, ToolChainGenesis _genesisPolicy)
   : m_initialParams(_config),
     m_engine(_config->sealEngine()),
     m_fork(new FORK(_config->params().atKey("fork"))),
     m_toolPath(_toolPath),
-    m_tmpDir(_tmpDir)
+    m_tmpDir(_tmpDir),
+    m_t8nDaemon(_t8nDaemon)
 {
     m_toolParams = GCP_SPointer<ToolParams>(new ToolParams(_config->params()));
 
@@ -87,18 +95,31 @@ ToolChain::ToolChain(
     EthereumBlockState genesisFixed(_genesis.header(), _genesis.state(), FH32::zero());
     if (_genesisPolicy == ToolChainGenesis::CALCULATE)
     {
-        // We yet don't know the state root of genesis. Ask the tool to calculate it
-        ToolResponse const res = mineBlockOnTool(_genesis, _genesis, SealEngine::NoReward);
-        genesisFixed.headerUnsafe().getContent().setStateRoot(res.stateRoot());
-        genesisFixed.headerUnsafe().getContent().recalculateHash();
-        genesisFixed.setTotalDifficulty(genesisFixed.header()->difficulty());
-
-        if (!checkStatesEqual(_genesis.state(), res.state()))
+        // The same pre state is used by every fork of a test and by many tests
+        auto& rootCache = GenesisRootCache::get();
+        string const cacheKey =
+            GenesisRootCache::makeKey(_genesis.state().getCContent(), rootCache.toolIdentity(_toolPath));
+        FH32 stateRoot(FH32::zero());
+        if (!rootCache.find(cacheKey, stateRoot))
         {
-            ETH_WARNING("T8N changed genesis state when asked to calculated it's hash only!");
-            compareStates(_genesis.state(), res.state());
-            ETH_ERROR_MESSAGE("T8N changed genesis state when asked to calculated it's hash only!");
+            // Genesis state root is just a trie of the pre state, no need to run the tool for it
+            if (!opt.cfgFile().nativeGenesisRoot() || !calculateStateRoot(_genesis.state().getCContent(), stateRoot))
+            {
+                // We yet don't know the state root of genesis. Ask the tool to calculate it
+                ToolResponse const res = mineBlockOnTool(_genesis, _genesis, SealEngine::NoReward);
+                if (!checkStatesEqual(_genesis.state(), res.state()))
+                {
+                    ETH_WARNING("T8N changed genesis state when asked to calculated it's hash only!");
+                    compareStates(_genesis.state(), res.state());
+                    ETH_ERROR_MESSAGE("T8N changed genesis state when asked to calculated it's hash only!");
+                }
+                stateRoot = res.stateRoot();
+            }
+            rootCache.record(cacheKey, stateRoot);
         }
+        genesisFixed.headerUnsafe().getContent().setStateRoot(stateRoot);
+        genesisFixed.headerUnsafe().getContent().recalculateHash();
+        genesisFixed.setTotalDifficulty(genesisFixed.header()->difficulty());
     }
 
     m_blocks.emplace_back(genesisFixed);
@@ -181,6 +202,8 @@ spDataObject const ToolChain::mineBlock(EthereumBlockState const& _pendingBlock,
     for (auto const& wt : _pendingBlock.withdrawals())
         pendingFixed.addWithdrawal(wt);
     correctUncleHeaders(pendingFixed, _pendingBlock);
+    if (Options::getCurrentConfig().cfgFile().checkTrieRoots())
+        checkTrieRootsAgainstRetesteth(pendingFixed);
 
     // Calculate header hash from header fields (does not recalc tx, un hashes)
     pendingFixed.headerUnsafe().getContent().recalculateHash();
@@ -201,10 +224,14 @@ ToolResponse ToolChain::mineBlockOnTool(
 {
     bool isGenesis = _currentBlock.header()->number() == _parentBlock.header()->number();
     BlockMining toolMiner(*this, _currentBlock, _parentBlock, isGenesis ? SealEngine::Genesis : _engine);
-    toolMiner.prepareEnvFile();
-    toolMiner.prepareAllocFile();
-    toolMiner.prepareTxnFile();
+    {
+        ProfileScope profile(ProfilePhase::PrepareInputs);
+        toolMiner.prepareEnvFile();
+        toolMiner.prepareAllocFile();
+        toolMiner.prepareTxnFile();
+    }
     toolMiner.executeTransition();
+    ProfileScope profile(ProfilePhase::ParseOutput);
     return toolMiner.readResult();
 }
 
@@ -263,6 +290,26 @@ void ToolChain::setAndCheckDifficulty(VALUE const& _difficulty, spBlockHeader& _
     }
 }
 
+void ToolChain::checkTrieRootsAgainstRetesteth(EthereumBlockState const& _pendingFixed)
+{
+    auto const& header = _pendingFixed.header().getCContent();
+    FH32 stateRoot(FH32::zero());
+    if (calculateStateRoot(_pendingFixed.state().getCContent(), stateRoot) && stateRoot != header.stateRoot())
+        ETH_ERROR_MESSAGE("tool vs retesteth stateRoot disagree: " + header.stateRoot().asString() + " vs " + stateRoot.asString());
+
+    FH32 const txRoot = calculateTransactionsRoot(_pendingFixed.transactions());
+    if (txRoot != header.transactionRoot())
+        ETH_ERROR_MESSAGE("tool vs retesteth transactionsRoot disagree: " + header.transactionRoot().asString() + " vs " + txRoot.asString());
+
+    if (isBlockExportWithdrawals(header))
+    {
+        FH32 const& toolRoot = BlockHeaderShanghai::castFrom(_pendingFixed.header()).withdrawalsRoot();
+        FH32 const wtRoot = calculateWithdrawalsRoot(_pendingFixed.withdrawals());
+        if (wtRoot != toolRoot)
+            ETH_ERROR_MESSAGE("tool vs retesteth withdrawalsRoot disagree: " + toolRoot.asString() + " vs " + wtRoot.asString());
+    }
+}
+
 void ToolChain::setWithdrawalsRoot(FH32 const& _withdrawalsRoot, spBlockHeader& _pendingHeader)
 {
     if (!_withdrawalsRoot.isZero())
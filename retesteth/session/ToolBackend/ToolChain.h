@@ -1,4 +1,5 @@
 #pragma once
+#include "T8NDaemon.h"
 #include <testStructures/types/Ethereum/EthereumBlock.h>
 #include <testStructures/types/RPC/SetChainParamsArgs.h>
 #include <testStructures/types/RPC/ToolResponse.h>
@@ -38,7 +39,8 @@ class ToolChain : public GCP_SPointerBase
 {
 public:
     ToolChain(EthereumBlockState const& _genesis, spSetChainParamsArgs const& _params, boost::filesystem::path const& _toolPath,
-        boost::filesystem::path const& _tmpDir, ToolChainGenesis _genesisPolicy = ToolChainGenesis::CALCULATE);
+        boost::filesystem::path const& _tmpDir, spT8NDaemon const& _t8nDaemon,
+        ToolChainGenesis _genesisPolicy = ToolChainGenesis::CALCULATE);
 
     // Calculate difficulty from _blockA to _blockB constructor
     ToolChain(EthereumBlockState const& _blockA, EthereumBlockState const& _blockB, FORK const& _fork,
@@ -68,6 +70,7 @@ public:
     // Used for chain reorg
     void insertBlock(EthereumBlockState const& _block) { m_blocks.emplace_back(_block); }
     boost::filesystem::path const& tmpDir() const { return m_tmpDir; }
+    spT8NDaemon t8nDaemon() const { return m_t8nDaemon; }
 
 private:
     ToolChain(){};
@@ -83,11 +86,13 @@ private:
     spFORK m_fork;
     boost::filesystem::path m_toolPath;
     boost::filesystem::path m_tmpDir;
+    spT8NDaemon m_t8nDaemon;
 
 private:
     void checkDifficultyAgainstRetesteth(VALUE const& _toolDifficulty, spBlockHeader const& _pendingHeader);
     void checkBasefeeAgainstRetesteth(VALUE const& _toolBasefee, spBlockHeader const& _pendingHeader, spBlockHeader const& _parentHeader);
     void calculateAndCheckSetBaseFee(VALUE const& _toolBaseFee, spBlockHeader& _pendingHeader, spBlockHeader const& _parentHeader);
+    void checkTrieRootsAgainstRetesteth(EthereumBlockState const& _pendingFixed);
     void setWithdrawalsRoot(FH32 const&, spBlockHeader&);
     void setExcessBlobGasAndGasUsed(ToolResponse const&, spBlockHeader&);
     void setAndCheckDifficulty(VALUE const&, spBlockHeader&);
@@ -3,6 +3,8 @@
 #include <retesteth/Options.h>
 #include <retesteth/testStructures/Common.h>
 #include <retesteth/Constants.h>
+#include <libdevcore/SHA3.h>
+#include <libdevcore/TrieHash.h>
 using namespace dev;
 using namespace test;
 using namespace std;
@@ -13,12 +15,31 @@ using namespace test::teststruct::constnames;
 namespace fs = boost::filesystem;
 
 namespace  {
+bigint const c_unreachableForkBlock = 10000000000;
+
 FORK convertForkToToolConfig(FORK const& _fork)
 {
     auto const& genesisSetupInTool = Options::getCurrentConfig().getGenesisTemplate(_fork);
     FORK const t8nForkName(genesisSetupInTool.getCContent().atKey("params").atKey("fork").asString());
     return t8nForkName;
 }
+
+bool isAccountEqual(AccountBase const& _a, AccountBase const& _b)
+{
+    if (_a.balance() != _b.balance() || _a.nonce() != _b.nonce() || !(_a.code() == _b.code()))
+        return false;
+    auto const& storageA = _a.storage().getKeys();
+    auto const& storageB = _b.storage().getKeys();
+    if (storageA.size() != storageB.size())
+        return false;
+    for (auto const& [key, record] : storageA)
+    {
+        auto const it = storageB.find(key);
+        if (it == storageB.end() || std::get<1>(record).getCContent() != std::get<1>(it->second).getCContent())
+            return false;
+    }
+    return true;
+}
 }
 
 namespace toolimpl
@@ -36,31 +57,30 @@ ToolParams::ToolParams(DataObject const& _data)
             {"chainID", {{DataType::String}, jsonField::Optional}}
         });
 
-    const bigint unreachable = 10000000000;
     if (_data.count("homesteadForkBlock"))
         m_homesteadForkBlock = sVALUE(_data.atKey("homesteadForkBlock"));
     else
-        m_homesteadForkBlock = sVALUE(unreachable);
+        m_homesteadForkBlock = sVALUE(c_unreachableForkBlock);
 
     if (_data.count("byzantiumForkBlock"))
         m_byzantiumForkBlock = sVALUE(_data.atKey("byzantiumForkBlock"));
     else
-        m_byzantiumForkBlock = sVALUE(unreachable);
+        m_byzantiumForkBlock = sVALUE(c_unreachableForkBlock);
 
     if (_data.count("constantinopleForkBlock"))
         m_constantinopleForkBlock = sVALUE(_data.atKey("constantinopleForkBlock"));
     else
-        m_constantinopleForkBlock = sVALUE(unreachable);
+        m_constantinopleForkBlock = sVALUE(c_unreachableForkBlock);
 
     if (_data.count("muirGlacierForkBlock"))
         m_muirGlacierForkBlock = sVALUE(_data.atKey("muirGlacierForkBlock"));
     else
-        m_muirGlacierForkBlock = sVALUE(unreachable);
+        m_muirGlacierForkBlock = sVALUE(c_unreachableForkBlock);
 
     if (_data.count("londonForkBlock"))
         m_londonForkBlock = sVALUE(_data.atKey("londonForkBlock"));
     else
-        m_londonForkBlock = sVALUE(unreachable);
+        m_londonForkBlock = sVALUE(c_unreachableForkBlock);
 }
 
 // We simulate the client backend side here, so thats why number5 is hardcoded
@@ -203,6 +223,53 @@ spState restoreFullState(DataObject& _toolState)
     return spState(new State(dataobject::move(fullState)));
 }
 
+spState restoreStateFromDiff(spState const& _preState, DataObject& _toolStateDiff)
+{
+    std::set<FH20> deletedAccounts;
+    spDataObject changedAccounts = sDataObject(DataType::Object);
+    for (auto& accTool : _toolStateDiff.getSubObjectsUnsafe())
+    {
+        if (accTool->type() == DataType::Null)
+            deletedAccounts.emplace(FH20(accTool->getKey()));
+        else
+            (*changedAccounts).addSubObject(accTool);
+    }
+
+    spState changedState = restoreFullState(changedAccounts.getContent());
+    std::map<FH20, spAccountBase> accounts;
+    changedState->forEachAccount([&accounts](FH20 const& _address, spAccountBase const& _acc) {
+        accounts.emplace_hint(accounts.end(), _address, _acc);
+    });
+    return spState(new State(_preState, accounts, deletedAccounts));
+}
+
+spState restoreStateOverlay(spState const& _preState, DataObject& _toolState)
+{
+    spState postState = restoreFullState(_toolState);
+    std::map<FH20, spAccountBase> changedAccounts;
+    size_t preAccountsFound = 0;
+    postState->forEachAccount([&](FH20 const& _address, spAccountBase const& _acc) {
+        if (_preState->hasAccount(_address))
+        {
+            preAccountsFound++;
+            if (isAccountEqual(_preState->getAccount(_address), _acc))
+                return;
+        }
+        changedAccounts.emplace_hint(changedAccounts.end(), _address, _acc);
+    });
+
+    // Accounts removed by the transition
+    std::set<FH20> deletedAccounts;
+    if (preAccountsFound != _preState->accountCount())
+    {
+        _preState->forEachAccount([&](FH20 const& _address, spAccountBase const&) {
+            if (!postState->hasAccount(_address))
+                deletedAccounts.emplace(_address);
+        });
+    }
+    return spState(new State(_preState, changedAccounts, deletedAccounts));
+}
+
 ChainOperationParams ChainOperationParams::defaultParams(ToolParams const& _params)
 {
     ChainOperationParams aleth;
@@ -214,47 +281,105 @@ ChainOperationParams ChainOperationParams::defaultParams(ToolParams const& _para
     aleth.constantinopleForkBlock = _params.constantinopleForkBlock().asBigInt();
     aleth.muirGlacierForkBlock = _params.muirGlacierForkBlock().asBigInt();
     aleth.londonForkBlock = _params.londonForkBlock().asBigInt();
+    aleth.arrowGlacierForkBlock = c_unreachableForkBlock;
+    aleth.grayGlacierForkBlock = c_unreachableForkBlock;
     return aleth;
 }
 
+bool ChainOperationParams::forkParams(FORK const& _fork, ChainOperationParams& _params)
+{
+    // Proof of work forks in the order of activation
+    static vector<string> const powForks = {"Frontier", "Homestead", "EIP150", "EIP158", "Byzantium", "Constantinople",
+        "ConstantinopleFix", "Istanbul", "MuirGlacier", "Berlin", "London", "ArrowGlacier", "GrayGlacier"};
+    auto const fork = std::find(powForks.begin(), powForks.end(), _fork.asString());
+    if (fork == powForks.end())
+        return false;
+
+    auto const forkBlock = [&fork](string const& _name) -> bigint {
+        return fork >= std::find(powForks.begin(), powForks.end(), _name) ? 0 : c_unreachableForkBlock;
+    };
+    _params.durationLimit = u256("0x0d");
+    _params.minimumDifficulty = u256("0x20000");
+    _params.difficultyBoundDivisor = u256("0x0800");
+    _params.homesteadForkBlock = forkBlock("Homestead");
+    _params.byzantiumForkBlock = forkBlock("Byzantium");
+    _params.constantinopleForkBlock = forkBlock("Constantinople");
+    _params.muirGlacierForkBlock = forkBlock("MuirGlacier");
+    _params.londonForkBlock = forkBlock("London");
+    _params.arrowGlacierForkBlock = forkBlock("ArrowGlacier");
+    _params.grayGlacierForkBlock = forkBlock("GrayGlacier");
+    return true;
+}
+
 // Aleth calculate difficulty formula
 VALUE calculateEthashDifficulty(
     ChainOperationParams const& _chainParams, BlockHeader const& _bi, BlockHeader const& _parent)
+{
+    if (_bi.number() == 0)
+        throw test::UpwardsException("[retesteth]: calculateEthashDifficulty was called for block with number == 0");
+    return calculateEthashDifficulty(_chainParams, _bi.number().asBigInt(), _bi.timestamp().asBigInt(),
+        _parent.number().asBigInt(), _parent.timestamp().asBigInt(), _parent.difficulty().asBigInt(), _parent.hasUncles());
+}
+
+VALUE calculateEthashDifficulty(ChainOperationParams const& _chainParams, bigint const& _number, bigint const& _timestamp,
+    bigint const& _parentNumber, bigint const& _parentTimestamp, bigint const& _parentDifficulty, bool _parentHasUncles)
 {
     const unsigned c_expDiffPeriod = 100000;
 
-    if (_bi.number() == 0)
+    if (_number == 0)
         throw test::UpwardsException("[retesteth]: calculateEthashDifficulty was called for block with number == 0");
 
     auto const& minimumDifficulty = _chainParams.minimumDifficulty;
     auto const& difficultyBoundDivisor = _chainParams.difficultyBoundDivisor;
     auto const& durationLimit = _chainParams.durationLimit;
 
-    VALUE target(0);  // stick to a bigint for the target. Don't want to risk going negative.
-    if (_bi.number() < _chainParams.homesteadForkBlock)
+    bigint target = 0;
+    if (_number < _chainParams.homesteadForkBlock)
     {
         // Frontier-era difficulty adjustment
-        target = _bi.timestamp() >= _parent.timestamp() + durationLimit ?
-                     _parent.difficulty() - (_parent.difficulty() / difficultyBoundDivisor) :
-                     (_parent.difficulty() + (_parent.difficulty() / difficultyBoundDivisor));
+        bigint const adjustment = _parentDifficulty / difficultyBoundDivisor;
+        target = _timestamp >= _parentTimestamp + durationLimit ? bigint(_parentDifficulty - adjustment) :
+                                                                  bigint(_parentDifficulty + adjustment);
     }
     else
     {
-        VALUE const timestampDiff = _bi.timestamp() - _parent.timestamp();
-        VALUE const adjFactor =
-            _bi.number() < _chainParams.byzantiumForkBlock ?
-                max<bigint>(1 - timestampDiff.asBigInt() / 10, -99) :  // Homestead-era difficulty adjustment
-                max<bigint>((_parent.hasUncles() ? 2 : 1) - timestampDiff.asBigInt() / 9,
+        bigint const timestampDiff = _timestamp - _parentTimestamp;
+        bigint const adjFactor =
+            _number < _chainParams.byzantiumForkBlock ?
+                max<bigint>(1 - timestampDiff / 10, -99) :  // Homestead-era difficulty adjustment
+                max<bigint>((_parentHasUncles ? 2 : 1) - timestampDiff / 9,
                     -99);  // Byzantium-era difficulty adjustment
 
-        target = _parent.difficulty() + _parent.difficulty() / 2048 * adjFactor;
+        target = _parentDifficulty + _parentDifficulty / 2048 * adjFactor;
     }
 
-    VALUE o = target;
-    unsigned exponentialIceAgeBlockNumber = (unsigned)_parent.number().asBigInt() + 1;
+    bigint o = target;
+    unsigned exponentialIceAgeBlockNumber = (unsigned)_parentNumber + 1;
 
+    // EIP-5133 Gray Glacier, EIP-4345 Arrow Glacier, EIP-3554 London Difficulty Bomb Delay
+    if (_number >= _chainParams.grayGlacierForkBlock)
+    {
+        if (exponentialIceAgeBlockNumber >= 11400000)
+            exponentialIceAgeBlockNumber -= 11400000;
+        else
+            exponentialIceAgeBlockNumber = 0;
+    }
+    else if (_number >= _chainParams.arrowGlacierForkBlock)
+    {
+        if (exponentialIceAgeBlockNumber >= 10700000)
+            exponentialIceAgeBlockNumber -= 10700000;
+        else
+            exponentialIceAgeBlockNumber = 0;
+    }
+    else if (_number >= _chainParams.londonForkBlock)
+    {
+        if (exponentialIceAgeBlockNumber >= 9700000)
+            exponentialIceAgeBlockNumber -= 9700000;
+        else
+            exponentialIceAgeBlockNumber = 0;
+    }
     // EIP-2384 Istanbul/Berlin Difficulty Bomb Delay
-    if (_bi.number().asBigInt() >= _chainParams.muirGlacierForkBlock)
+    else if (_number >= _chainParams.muirGlacierForkBlock)
     {
         if (exponentialIceAgeBlockNumber >= 9000000)
             exponentialIceAgeBlockNumber -= 9000000;
@@ -262,7 +387,7 @@ VALUE calculateEthashDifficulty(
             exponentialIceAgeBlockNumber = 0;
     }
     // EIP-1234 Constantinople Ice Age delay
-    else if (_bi.number().asBigInt() >= _chainParams.constantinopleForkBlock)
+    else if (_number >= _chainParams.constantinopleForkBlock)
     {
         if (exponentialIceAgeBlockNumber >= 5000000)
             exponentialIceAgeBlockNumber -= 5000000;
@@ -270,7 +395,7 @@ VALUE calculateEthashDifficulty(
             exponentialIceAgeBlockNumber = 0;
     }
     // EIP-649 Byzantium Ice Age delay
-    else if (_bi.number().asBigInt() >= _chainParams.byzantiumForkBlock)
+    else if (_number >= _chainParams.byzantiumForkBlock)
     {
         if (exponentialIceAgeBlockNumber >= 3000000)
             exponentialIceAgeBlockNumber -= 3000000;
@@ -281,10 +406,9 @@ VALUE calculateEthashDifficulty(
     unsigned periodCount = exponentialIceAgeBlockNumber / c_expDiffPeriod;
     // latter will eventually become huge, so ensure it's a bigint.
     if (periodCount > 1)
-        o += VALUE((bigint(1) << (periodCount - 2)));
+        o += bigint(1) << (periodCount - 2);
 
-    o = max<bigint>(minimumDifficulty, o.asBigInt());
-    return o;  // bigint(min<bigint>(o, std::numeric_limits<bigint>::max()));
+    return VALUE(max<bigint>(minimumDifficulty, o));  // bigint(min<bigint>(o, std::numeric_limits<bigint>::max()));
 }
 
 
@@ -318,4 +442,62 @@ VALUE calculateEIP1559BaseFee(ChainOperationParams const& _chainParams, spBlockH
     return expectedBaseFee;
 }
 
+bool calculateStateRoot(State const& _state, FH32& _root)
+{
+    BytesMap stateTrie;
+    bool supported = true;
+    _state.forEachAccount([&](FH20 const& _address, spAccountBase const& _acc) {
+        if (!supported || _acc->balance().isBigInt() || _acc->nonce().isBigInt())
+        {
+            supported = false;
+            return;
+        }
+
+        BytesMap storageTrie;
+        for (auto const& [keyStr, record] : _acc->storage().getKeys())
+        {
+            VALUE const& key = std::get<0>(record);
+            VALUE const& value = std::get<1>(record);
+            if (key.isBigInt() || value.isBigInt() || key.asBigInt() > dev::u256(-1) || key.asBigInt() < 0)
+            {
+                supported = false;
+                return;
+            }
+            // Zero values are not stored in the trie
+            if (value.serializeRLP().empty())
+                continue;
+            storageTrie[h256(dev::u256(key.asBigInt())).asBytes()] = rlp(value.serializeRLP());
+        }
+
+        RLPStream account(4);
+        account << _acc->nonce().serializeRLP();
+        account << _acc->balance().serializeRLP();
+        account << secureTrieRoot(storageTrie);
+        account << sha3(fromHex(_acc->code().asString()));
+        stateTrie[_address.serializeRLP()] = account.out();
+    });
+    if (!supported)
+        return false;
+    _root = FH32("0x" + secureTrieRoot(stateTrie).hex());
+    return true;
+}
+
+FH32 calculateTransactionsRoot(std::vector<spTransaction> const& _transactions)
+{
+    std::vector<bytes> items;
+    items.reserve(_transactions.size());
+    for (auto const& tr : _transactions)
+        items.emplace_back(fromHex(tr->getRawBytes().asString()));
+    return FH32("0x" + orderedTrieRoot(items).hex());
+}
+
+FH32 calculateWithdrawalsRoot(std::vector<spWithdrawal> const& _withdrawals)
+{
+    std::vector<bytes> items;
+    items.reserve(_withdrawals.size());
+    for (auto const& wt : _withdrawals)
+        items.emplace_back(wt->asRLPStream().out());
+    return FH32("0x" + orderedTrieRoot(items).hex());
+}
+
 }  // namespace toolimpl
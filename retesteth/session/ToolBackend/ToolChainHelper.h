@@ -9,6 +9,9 @@ namespace toolimpl
 struct ChainOperationParams
 {
     static ChainOperationParams defaultParams(ToolParams const& _params);
+
+    // Rules of the mainnet _fork active from genesis, false if _fork is not a proof of work fork known here
+    static bool forkParams(FORK const& _fork, ChainOperationParams& _params);
     dev::bigint minimumDifficulty;
     dev::bigint difficultyBoundDivisor;
     dev::bigint durationLimit;
@@ -17,12 +20,29 @@ struct ChainOperationParams
     dev::bigint muirGlacierForkBlock;
     dev::bigint constantinopleForkBlock;
     dev::bigint londonForkBlock;
+    dev::bigint arrowGlacierForkBlock;
+    dev::bigint grayGlacierForkBlock;
 };
 std::tuple<VALUE, FORK> prepareReward(SealEngine _engine, FORK const& _fork, EthereumBlockState const&);
 VALUE calculateGasLimit(VALUE const& _parentGasLimit, VALUE const& _parentGasUsed);
 VALUE calculateEthashDifficulty(
     ChainOperationParams const& _chainParams, BlockHeader const& _bi, BlockHeader const& _parent);
+VALUE calculateEthashDifficulty(ChainOperationParams const& _chainParams, dev::bigint const& _number, dev::bigint const& _timestamp,
+    dev::bigint const& _parentNumber, dev::bigint const& _parentTimestamp, dev::bigint const& _parentDifficulty,
+    bool _parentHasUncles);
 VALUE calculateEIP1559BaseFee(ChainOperationParams const& _chainParams, spBlockHeader const& _bi, spBlockHeader const& _parent);
 spState restoreFullState(DataObject& _toolState);
 
+// Apply t8n alloc diff {address : account | null} to the pre state. Unchanged accounts are shared with _preState
+spState restoreStateFromDiff(spState const& _preState, DataObject& _toolStateDiff);
+
+// Restore t8n full post alloc as overlay of the pre state, keeping only changed accounts
+spState restoreStateOverlay(spState const& _preState, DataObject& _toolState);
+
+// Roots of the Merkle Patricia tries computed by retesteth
+// False if the state has values that only the tool can handle (bigint test cases)
+bool calculateStateRoot(State const& _state, FH32& _root);
+FH32 calculateTransactionsRoot(std::vector<spTransaction> const& _transactions);
+FH32 calculateWithdrawalsRoot(std::vector<spWithdrawal> const& _withdrawals);
+
 }  // namespace toolimpl
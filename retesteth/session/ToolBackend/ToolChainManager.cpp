@@ -21,6 +21,7 @@ ToolChainManager::ToolChainManager(
     spSetChainParamsArgs const& _config,
     fs::path const& _toolPath,
     fs::path const& _tmpDir,
+    spT8NDaemon const& _t8nDaemon,
     ToolChainGenesis _genesisPolicy)
 {
     m_tmpDir = _tmpDir;
@@ -28,7 +29,7 @@ ToolChainManager::ToolChainManager(
     m_currentChain = 0;
     m_maxChains = 0;
     EthereumBlockState genesis(_config->genesis(), _config->state(), FH32::zero());
-    m_chains[m_currentChain] = spToolChain(new ToolChain(genesis, _config, _toolPath, _tmpDir, _genesisPolicy));
+    m_chains[m_currentChain] = spToolChain(new ToolChain(genesis, _config, _toolPath, _tmpDir, _t8nDaemon, _genesisPolicy));
     m_pendingBlock =
         spEthereumBlockState(new EthereumBlockState(currentChain().lastBlock().header(), _config->state(), FH32::zero()));
     reorganizePendingBlock();
@@ -134,7 +135,7 @@ void ToolChainManager::reorganizeChainForParent(FH32 const& _parentHash)
                 {
                     // clone existing chain up to this block
                     m_chains[++m_maxChains] =
-                        spToolChain(new ToolChain(blocks.at(0), rchain.params(), rchain.toolPath(), rchain.tmpDir()));
+                        spToolChain(new ToolChain(blocks.at(0), rchain.params(), rchain.toolPath(), rchain.tmpDir(), rchain.t8nDaemon()));
                     m_currentChain = m_maxChains;
                     for (size_t j = 1; j <= i; j++)
                         m_chains[m_currentChain].getContent().insertBlock(blocks.at(j));
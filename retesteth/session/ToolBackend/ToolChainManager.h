@@ -20,7 +20,8 @@ enum class AddPendingTransaction
 class ToolChainManager : public GCP_SPointerBase
 {
 public:
-    ToolChainManager(spSetChainParamsArgs const& _config, boost::filesystem::path const& _toolPath, boost::filesystem::path const& _tmpDir, ToolChainGenesis _genesisPolicy = ToolChainGenesis::CALCULATE);
+    ToolChainManager(spSetChainParamsArgs const& _config, boost::filesystem::path const& _toolPath, boost::filesystem::path const& _tmpDir,
+        spT8NDaemon const& _t8nDaemon, ToolChainGenesis _genesisPolicy = ToolChainGenesis::CALCULATE);
     void addPendingTransaction(spTransaction const& _tr, AddPendingTransaction);
 
     ToolChain const& currentChain() const
@@ -41,10 +42,15 @@ public:
     // Transaction tests
     static TestRawTransaction test_rawTransaction(
         BYTES const& _rlp, FORK const& _fork, boost::filesystem::path const& _toolPath, boost::filesystem::path const& _tmpDir);
+    // Validate all transactions with one t9n call. Empty result means do them one by one
+    static std::vector<TestRawTransaction> test_rawTransactions(std::vector<BYTES> const& _rlps, FORK const& _fork,
+        boost::filesystem::path const& _toolPath, boost::filesystem::path const& _tmpDir);
 
     // EOF tests
     static std::string test_rawEOFCode(
         BYTES const& _code, FORK const& _fork, boost::filesystem::path const& _toolPath, boost::filesystem::path const& _tmpDir);
+    // Validate the code on a running `eof` tool process that reads hex codes from stdin line by line
+    static std::string test_rawEOFCode(BYTES const& _code, T8NDaemon& _process);
 
     // Difficulty tests
     static VALUE test_calculateDifficulty(FORK const& _fork, VALUE const& _blockNumber, VALUE const& _parentTimestamp,
@@ -7,27 +7,28 @@ using namespace std;
 
 namespace toolimpl
 {
+// The range key is the next address to return marked with a leading 0x01 byte, the first key 1 starts from the beginning
 spDataObject constructAccountRange(EthereumBlockState const& _block, FH32 const& _addrHash, size_t _maxResult)
 {
-    size_t k = 0;
-    size_t iAcc = hexOrDecStringToInt(_addrHash.asString());
+    string const key = _addrHash.asString();
+    FH20 const from = key.substr(2, 2) == "01" ? FH20("0x" + key.substr(26)) : FH20::zero();
+
     spDataObject constructResponse;
     spDataObject emptyList(new DataObject(DataType::Object));
     (*constructResponse).atKeyPointer("addressMap") = emptyList;
-    for (auto const& acc : _block.state()->accounts())
-    {
-        if (k++ + 1 < iAcc)  // The first key is 1 must be included
-            continue;
+    (*constructResponse)["nextKey"] = test::stoCompactHexPrefixed(0, 32);
 
-        spDataObject address(new DataObject(acc.first.asString()));
-        (*constructResponse)["addressMap"].addSubObject(fto_string(iAcc++), address);
-        if (constructResponse->atKey("addressMap").getSubObjects().size() == _maxResult)
-            break;
-    }
-    if (constructResponse->atKey("addressMap").getSubObjects().size() == 0)
-        (*constructResponse)["nextKey"] = test::stoCompactHexPrefixed(0, 32);
-    else
-        (*constructResponse)["nextKey"] = test::stoCompactHexPrefixed(k + 1, 32);  // because we rely on empty structure +1
+    size_t added = 0;
+    _block.state()->forEachAccountFrom(from, [&](FH20 const& _address, spAccountBase const&) {
+        if (added == _maxResult)
+        {
+            (*constructResponse)["nextKey"] = "0x01" + string(22, '0') + _address.asString().substr(2);
+            return false;
+        }
+        spDataObject address(new DataObject(_address.asString()));
+        (*constructResponse)["addressMap"].addSubObject(fto_string(added++), address);
+        return true;
+    });
     return constructResponse;
 }
 
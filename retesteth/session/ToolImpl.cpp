@@ -222,6 +222,17 @@ DebugStorageRangeAt ToolImpl::debug_storageRangeAt(
     return DebugStorageRangeAt(DataObject());
 }
 
+spState ToolImpl::lastBlockState()
+{
+    rpcCall("", {});
+    ETH_DC_MESSAGE(DC::RPC2, "\nRequest: lastBlockState");
+    TRYCATCHCALL(
+        // No copy, the chain does not modify states of mined blocks
+        return blockchain().lastBlock().state();
+        , "lastBlockState", CallType::FAILEVERYTHING, DC::RPC2)
+    return spState(0);
+}
+
 DebugVMTrace ToolImpl::debug_traceTransaction(FH32 const& _trHash)
 {
     rpcCall("", {});
@@ -240,7 +251,7 @@ void ToolImpl::test_setChainParams(spSetChainParamsArgs const& _config)
 
     // Ask tool to calculate genesis header stateRoot for genesisHeader
     TRYCATCHCALL(
-        m_toolChainManager = GCP_SPointer<ToolChainManager>(new ToolChainManager(_config, m_toolPath, m_tmpDir));
+        m_toolChainManager = GCP_SPointer<ToolChainManager>(new ToolChainManager(_config, m_toolPath, m_tmpDir, t8nDaemon()));
         ETH_DC_MESSAGE(DC::RPC, "Response test_setChainParams: {true}");
         , "test_setChainParams", CallType::FAILEVERYTHING, DC::RPC)
     ETH_DC_MESSAGE(DC::RPC, "Response test_setChainParams: {false}");
@@ -253,7 +264,7 @@ void ToolImpl::test_setChainParamsNoGenesis(spSetChainParamsArgs const& _config)
 
     // Ask tool to calculate genesis header stateRoot for genesisHeader
     TRYCATCHCALL(
-        m_toolChainManager = GCP_SPointer<ToolChainManager>(new ToolChainManager(_config, m_toolPath, m_tmpDir, ToolChainGenesis::NOTCALCULATE));
+        m_toolChainManager = GCP_SPointer<ToolChainManager>(new ToolChainManager(_config, m_toolPath, m_tmpDir, t8nDaemon(), ToolChainGenesis::NOTCALCULATE));
         ETH_DC_MESSAGE(DC::RPC, "Response test_setChainParams: {true}");
         , "test_setChainParams", CallType::FAILEVERYTHING, DC::RPC)
     ETH_DC_MESSAGE(DC::RPC, "Response test_setChainParams: {false}");
@@ -336,6 +347,19 @@ TestRawTransaction ToolImpl::test_rawTransaction(BYTES const& _rlp, FORK const&
     return TestRawTransaction(DataObject());
 }
 
+std::vector<TestRawTransaction> ToolImpl::test_rawTransactions(std::vector<BYTES> const& _rlps, FORK const& _fork)
+{
+    auto const& genesisSetupInTool = Options::getCurrentConfig().getGenesisTemplate(_fork);
+    FORK t8nForkName(genesisSetupInTool.getCContent().atKey("params").atKey("fork").asString());
+
+    rpcCall("", {});
+    TRYCATCHCALL(
+        ETH_DC_MESSAGE(DC::RPC, "\nRequest: test_rawTransactions " + test::fto_string(_rlps.size()) + " transactions, Fork: `" + t8nForkName.asString());
+        return ToolChainManager::test_rawTransactions(_rlps, t8nForkName, m_toolPath, m_tmpDir);
+        , "test_rawTransactions", CallType::DONTFAILONUPWARDS, DC::RPC)
+    return std::vector<TestRawTransaction>();
+}
+
 std::string ToolImpl::test_rawEOFCode(BYTES const& _code, FORK const& _fork)
 {
     auto const& genesisSetupInTool = Options::getCurrentConfig().getGenesisTemplate(_fork);
@@ -344,7 +368,9 @@ std::string ToolImpl::test_rawEOFCode(BYTES const& _code, FORK const& _fork)
     rpcCall("", {});
     TRYCATCHCALL(
         ETH_DC_MESSAGE(DC::RPC, "\nRequest: test_rawEOFCode '" + _code.asString().substr(0, 50) + "', Fork: `" + t8nForkName.asString());
-        string res = ToolChainManager::test_rawEOFCode(_code, t8nForkName, m_toolPath, m_tmpDir);
+        string res;
+        if (!rawEOFCodeStdio(_code, t8nForkName, res))
+            res = ToolChainManager::test_rawEOFCode(_code, t8nForkName, m_toolPath, m_tmpDir);
         return res;
         , "test_rawTransaction", CallType::DONTFAILONUPWARDS, DC::RPC)
     return string();
@@ -403,4 +429,40 @@ void ToolImpl::makeRPCError(string const& _error)
     m_lastInterfaceError = RPCError("", _error);
 }
 
+bool ToolImpl::rawEOFCodeStdio(BYTES const& _code, FORK const& _t8nFork, string& _result)
+{
+    if (!Options::getCurrentConfig().cfgFile().eofStdio() || m_eofStdioFailed)
+        return false;
+    try
+    {
+        auto& process = m_eofProcesses[_t8nFork.asString()];
+        if (process.isEmpty())
+        {
+            size_t const timeout = Options::getCurrentConfig().cfgFile().t8nDaemonTimeout();
+            process = spT8NDaemon(new T8NDaemon(m_toolPath, timeout, {"eof", "--state.fork", _t8nFork.asString()}));
+        }
+        _result = ToolChainManager::test_rawEOFCode(_code, process.getContent());
+        return true;
+    }
+    catch (UpwardsException const& _ex)
+    {
+        // Do not try again, the tool is called for each code from now on
+        ETH_WARNING(string("EOF validation via stdin failed, calling the tool for each code: ") + _ex.what());
+        m_eofStdioFailed = true;
+        m_eofProcesses.clear();
+    }
+    return false;
+}
+
+spT8NDaemon const& ToolImpl::t8nDaemon()
+{
+    if (m_t8nDaemon.isEmpty())
+    {
+        auto const& cfg = Options::getCurrentConfig().cfgFile();
+        if (!cfg.t8nDaemon().empty())
+            m_t8nDaemon = spT8NDaemon(new T8NDaemon(cfg.t8nDaemon(), cfg.t8nDaemonTimeout()));
+    }
+    return m_t8nDaemon;
+}
+
 }  // namespace test::session
@@ -39,6 +39,7 @@ public:
     DebugStorageRangeAt debug_storageRangeAt(
         FH32 const& _blockHash, VALUE const& _txIndex, FH20 const& _address, FH32 const& _begin, int _maxResults) override;
     DebugVMTrace debug_traceTransaction(FH32 const& _trHash) override;
+    spState lastBlockState() override;
 
     // Test
     void test_setChainParams(spSetChainParamsArgs const& _config) override;
@@ -50,6 +51,7 @@ public:
     void test_registerWithdrawal(BYTES const& _rlp) override;
     FH32 test_getLogHash(FH32 const& _txHash) override;
     TestRawTransaction test_rawTransaction(BYTES const& _rlp, FORK const& _fork) override;
+    std::vector<TestRawTransaction> test_rawTransactions(std::vector<BYTES> const& _rlps, FORK const& _fork) override;
     std::string test_rawEOFCode(BYTES const& _code, FORK const& _fork) override;
     VALUE test_calculateDifficulty(FORK const& _fork, VALUE const& _blockNumber, VALUE const& _parentTimestamp,
         VALUE const& _parentDifficulty, VALUE const& _currentTimestamp, VALUE const& _uncleNumber) override;
@@ -69,9 +71,18 @@ private:
     size_t m_totalCalls = 0;
     toolimpl::ToolChainManager& blockchain() { return m_toolChainManager.getContent(); }
     void makeRPCError(std::string const& _error);
+    toolimpl::spT8NDaemon const& t8nDaemon();
+    bool rawEOFCodeStdio(BYTES const& _code, FORK const& _t8nFork, std::string& _result);
 
     // Manage blockchains as ethereum client backend
     GCP_SPointer<toolimpl::ToolChainManager> m_toolChainManager;
+
+    // Persistent t8n process of this session if configured by client config
+    toolimpl::spT8NDaemon m_t8nDaemon;
+
+    // `eof` tool processes of this session by fork, if eofStdio is configured by client config
+    std::map<std::string, toolimpl::spT8NDaemon> m_eofProcesses;
+    bool m_eofStdioFailed = false;
 };
 
 }  // namespace test::session
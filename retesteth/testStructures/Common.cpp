@@ -434,6 +434,34 @@ void convertDecTransactionToHex(spDataObject& _data)
     data[c_to].performModifier(mod_valueToLowerCase);
 }
 
+void precompileFillerCodes(DataObject const& _filler)
+{
+    std::vector<string> codes;
+    auto const addCode = [&codes](DataObject const& _code) {
+        if (_code.type() == DataType::String)
+            codes.emplace_back(_code.asString());
+    };
+
+    if (_filler.count("pre"))
+        for (auto const& acc : _filler.atKey("pre").getSubObjects())
+            if (acc->count(c_code))
+                addCode(acc->atKey(c_code));
+
+    // State test data is a list of codes or of {data, accessList}
+    if (_filler.count("transaction") && _filler.atKey("transaction").count(c_data))
+        for (auto const& data : _filler.atKey("transaction").atKey(c_data).getSubObjects())
+            addCode(data->type() == DataType::Object && data->count(c_data) ? data->atKey(c_data) : data.getCContent());
+
+    if (_filler.count("blocks"))
+        for (auto const& block : _filler.atKey("blocks").getSubObjects())
+            if (block->count("transactions"))
+                for (auto const& tr : block->atKey("transactions").getSubObjects())
+                    if (tr->count(c_data))
+                        addCode(tr->atKey(c_data));
+
+    test::compiler::precompileCodes(codes);
+}
+
 bool src_findBigInt(DataObject const& el)
 {
     if (el.type() == DataType::String && el.asString().find(C_BIGINT_PREFIX) != string::npos)
@@ -449,27 +477,27 @@ void mod_changeValueAnyToBigint00(DataObject& _el)
 
 bool checkEmptyAccounts(spState _state)
 {
-    for (auto const& [address, acc] : _state->accounts())
-    {
-        if (acc->nonce() == 0 && acc->balance() == 0 && acc->code().asString() == "0x")
-            return true;
-    }
-    return false;
+    bool hasEmptyAccount = false;
+    _state->forEachAccountFrom(FH20::zero(), [&hasEmptyAccount](FH20 const&, spAccountBase const& _acc) {
+        hasEmptyAccount = _acc->nonce() == 0 && _acc->balance() == 0 && _acc->code().asString() == "0x";
+        return !hasEmptyAccount;
+    });
+    return hasEmptyAccount;
 }
 
 void checkEmptyStorages(spState _state)
 {
-    for (auto const& [address, acc] : _state->accounts())
-    {
-        for (auto const& [str, record] : acc->storage().getKeys())
+    _state->forEachAccountFrom(FH20::zero(), [](FH20 const& _address, spAccountBase const& _acc) {
+        for (auto const& [str, record] : _acc->storage().getKeys())
         {
             if (std::get<1>(record)->asBigInt() == 0)
             {
-                ETH_ERROR_MESSAGE("Pre state has empty storage record in account: " + address.asString() + TestOutputHelper::get().testInfo().errorDebug());
-                return;
+                ETH_ERROR_MESSAGE("Pre state has empty storage record in account: " + _address.asString() + TestOutputHelper::get().testInfo().errorDebug());
+                return false;
             }
         }
-    }
+        return true;
+    });
 }
 
 spAccountBase makeBeaconAccount()
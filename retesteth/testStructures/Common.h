@@ -61,6 +61,9 @@ void convertDecStateToHex(spDataObject& _data,
 
 void convertDecTransactionToHex(spDataObject& _data);
 
+// Compile codes of the filler pre state and transactions at once, before they are converted one by one
+void precompileFillerCodes(DataObject const& _filler);
+
 // Convert dec fields to hex, add 0x prefix to accounts and storage keys
 spDataObject convertDecBlockheaderIncompleteToHex(DataObject const& _data);
 
@@ -192,8 +192,9 @@ spSetChainParamsArgs prepareChainParams(
     (*genesis).atKeyPointer("genesis") = prepareGenesisSubsection(_env, _context, _net);
 
     // Because of template might contain preset accounts
-    for (auto const& el : _state.accounts())
-        (*genesis)["accounts"].addSubObject(el.second->asDataObject());
+    _state.forEachAccount([&genesis](FH20 const&, spAccountBase const& _acc) {
+        (*genesis)["accounts"].addSubObject(_acc->asDataObject());
+    });
     return spSetChainParamsArgs(new SetChainParamsArgs(genesis));
 }
 
@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace test::teststruct
+{
+// Per object once-initialization of lazily calculated caches (string/rlp representation of a value)
+// Reading a ready cache takes no lock. Concurrent first readers of the same object wait for the one calculating
+class CacheFlag
+{
+public:
+    CacheFlag() {}
+    CacheFlag(CacheFlag const& _other) : m_state(_other.ready() ? c_ready : c_empty) {}
+    CacheFlag& operator=(CacheFlag const& _other)
+    {
+        m_state.store(_other.ready() ? c_ready : c_empty, std::memory_order_release);
+        return *this;
+    }
+
+    bool ready() const { return m_state.load(std::memory_order_acquire) == c_ready; }
+
+    // Object value has changed. Only called by the owner of non const object
+    void reset() { m_state.store(c_empty, std::memory_order_release); }
+
+    template <class F>
+    void initialize(F const& _calculate) const
+    {
+        if (ready())
+            return;
+
+        uint8_t expected = c_empty;
+        if (m_state.compare_exchange_strong(expected, c_busy, std::memory_order_acquire))
+        {
+            try
+            {
+                _calculate();
+            }
+            catch (...)
+            {
+                m_state.store(c_empty, std::memory_order_release);
+                throw;
+            }
+            m_state.store(c_ready, std::memory_order_release);
+            return;
+        }
+
+        while (!ready())
+        {
+            // Calculation failed in the other thread, try it here
+            if (m_state.load(std::memory_order_acquire) == c_empty)
+                return initialize(_calculate);
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    static constexpr uint8_t c_empty = 0;
+    static constexpr uint8_t c_busy = 1;
+    static constexpr uint8_t c_ready = 2;
+    mutable std::atomic<uint8_t> m_state = c_empty;
+};
+
+}  // namespace teststruct
@@ -7,8 +7,6 @@ using namespace test::teststruct;
 using namespace dev;
 using namespace std;
 
-std::mutex g_cacheAccessMutexFH;
-
 namespace
 {
 bool validateHash(std::string const& _hash, size_t _size)
@@ -23,6 +21,20 @@ bool validateHash(std::string const& _hash, size_t _size)
 namespace test::teststruct
 {
 
+void FH::_setBytes(dev::bytes const& _bytes)
+{
+    if (m_isCorrectHash && _bytes.size() == m_scale && m_scale <= c_inlineSize)
+    {
+        std::copy(_bytes.begin(), _bytes.end(), m_inline.begin());
+        m_isInline = true;
+    }
+    else
+    {
+        m_bytes = _bytes;
+        m_isInline = false;
+    }
+}
+
 void FH::_initialize(string const& _data, string const& _key)
 {
     string const scale = to_string(m_scale);
@@ -37,7 +49,7 @@ void FH::_initialize(string const& _data, string const& _key)
             else
                 throw test::UpwardsException("Key `" + _key + "` is not hash" + scale + " `" + _data + "`");
         }
-        m_data = BYTES(_data);
+        _setBytes(test::sfromHex(BYTES(_data).asString()));
     }
     else
     {
@@ -45,13 +57,9 @@ void FH::_initialize(string const& _data, string const& _key)
         // pos += 10;  // length of prefix
         try
         {
-            if (validateHash(_data, m_scale))
-                m_data = BYTES(_data.substr(pos + 10));
-            else
-            {
+            if (!validateHash(_data, m_scale))
                 m_isCorrectHash = false;
-                m_data = BYTES(_data.substr(pos + 10));
-            }
+            _setBytes(test::sfromHex(BYTES(_data.substr(pos + 10)).asString()));
         }
         catch (std::exception const& _ex)
         {
@@ -74,31 +82,49 @@ FH::FH(DataObject const& _data, size_t _scale) : m_scale(_scale)
 
 FH::FH(dev::RLP const& _rlp, size_t _scale)
 {
-    m_data = BYTES(_rlp);
     m_scale = _scale;
+    dev::bytes const data = _rlp.toBytes();
+    if (data.size() != _scale)
+        m_isCorrectHash = false;
+    _setBytes(data);
+}
 
-    size_t const gotScale = (m_data.asString().size() - 2) / 2;
+FH& FH::operator=(FH const& _other)
+{
+    // Reference counter of the smart pointer base is not copied
+    m_inline = _other.m_inline;
+    m_bytes = _other.m_bytes;
+    m_isInline = _other.m_isInline;
+    m_scale = _other.m_scale;
+    m_isCorrectHash = _other.m_isCorrectHash;
+    m_dataStrReady.reset();
+    m_dataStrZeroXReady.reset();
+    m_rlpDataReady.reset();
+    return *this;
+}
 
-    if (gotScale != _scale)
-        m_isCorrectHash = false;
+string const& FH::asStringBytes() const
+{
+    m_dataStrReady.initialize([this]() { m_dataStrCache = dev::toHex(data(), data() + size(), "0x"); });
+    return m_dataStrCache;
 }
 
 string const& FH::asString() const
 {
-    std::lock_guard<std::mutex> lock(g_cacheAccessMutexFH);
-    if (m_dataStrZeroXCache.empty())
-    {
-        m_dataStrZeroXCache = m_data.asString();
-        if (!m_isCorrectHash)
-            m_dataStrZeroXCache.insert(0, C_BIGINT_PREFIX);
-    }
+    if (m_isCorrectHash)
+        return asStringBytes();
+    m_dataStrZeroXReady.initialize([this]() {
+        m_dataStrZeroXCache = asStringBytes();
+        m_dataStrZeroXCache.insert(0, C_BIGINT_PREFIX);
+    });
     return m_dataStrZeroXCache;
 }
 
 dev::bytes const& FH::serializeRLP() const
 {
-    if (m_rlpDataCache.empty())
-        m_rlpDataCache = test::sfromHex(m_data.asString());
+    if (!m_isInline)
+        return m_bytes;
+    m_rlpDataReady.initialize([this]() { m_rlpDataCache = dev::bytes(data(), data() + size()); });
     return m_rlpDataCache;
 }
 
@@ -1,5 +1,9 @@
 #pragma once
 #include "BYTES.h"
+#include "CacheFlag.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <libdevcore/RLP.h>
 #include <libdataobj/DataObject.h>
 
@@ -10,13 +14,22 @@ struct FH : dataobject::GCP_SPointerBase
     FH(dev::RLP const& _rlp, size_t _scale);
     FH(std::string const&, size_t _scale);
     FH(dataobject::DataObject const&, size_t _scale);  // Does not require to move smart pointer here as this structure changes a lot
+    FH(FH const& _other) : dataobject::GCP_SPointerBase() { *this = _other; }
+    FH& operator=(FH const& _other);
 
     std::string const& asString() const;
     dev::bytes const& serializeRLP() const;
-    std::string const& asStringBytes() const { return m_data.asString(); }
-    bool operator==(FH const& rhs) const { return m_data.asString() == rhs.asStringBytes(); }
-    bool operator!=(FH const& rhs) const { return m_data.asString() != rhs.asStringBytes(); }
-    bool operator<(FH const& rhs) const { return m_data.asString() < rhs.asStringBytes(); }
+    std::string const& asStringBytes() const;
+    bool operator==(FH const& rhs) const
+    {
+        return size() == rhs.size() && std::memcmp(data(), rhs.data(), size()) == 0;
+    }
+    bool operator!=(FH const& rhs) const { return !(*this == rhs); }
+    bool operator<(FH const& rhs) const
+    {
+        // Same order as of hex strings
+        return std::lexicographical_compare(data(), data() + size(), rhs.data(), rhs.data() + rhs.size());
+    }
 
     size_t scale() const { return m_scale; }
 
@@ -24,13 +37,25 @@ private:
     FH() {}
     //FH(FH const&) {}
     void _initialize(std::string const& _s, std::string const& _k = std::string());
+    void _setBytes(dev::bytes const& _bytes);
+    uint8_t const* data() const { return m_isInline ? m_inline.data() : m_bytes.data(); }
+    size_t size() const { return m_isInline ? m_scale : m_bytes.size(); }
 
 protected:
-    BYTES m_data = BYTES("0x00");
+    // Hashes up to 32 bytes of correct size are kept inline in binary form, hex is made on demand
+    // Longer hashes (bloom) and malicious hashes of wrong size are kept in m_bytes
+    static size_t const c_inlineSize = 32;
+    std::array<uint8_t, c_inlineSize> m_inline;
+    dev::bytes m_bytes;
+    bool m_isInline = false;
     size_t m_scale;
     bool m_isCorrectHash = true;
+    mutable std::string m_dataStrCache;
     mutable std::string m_dataStrZeroXCache;
     mutable dev::bytes m_rlpDataCache;
+    CacheFlag m_dataStrReady;
+    CacheFlag m_dataStrZeroXReady;
+    CacheFlag m_rlpDataReady;
 };
 
 }  // namespace teststruct
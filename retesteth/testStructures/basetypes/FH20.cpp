@@ -24,5 +24,5 @@ FH20 FH20::random()
 
 FH20* FH20::copy() const
 {
-    return new FH20(asString());
+    return new FH20(*this);
 }
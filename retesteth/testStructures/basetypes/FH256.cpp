@@ -9,5 +9,5 @@ FH256 const& FH256::zero()
 
 FH256* FH256::copy() const
 {
-    return new FH256(asString());
+    return new FH256(*this);
 }
@@ -9,5 +9,5 @@ FH32 const& FH32::zero()
 
 FH32* FH32::copy() const
 {
-    return new FH32(asString());
+    return new FH32(*this);
 }
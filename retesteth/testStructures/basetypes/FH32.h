@@ -13,7 +13,7 @@ struct FH32 : FH
     FH32(std::string const& _data) : FH(_data, 32) {}
     FH32* copy() const;
 
-    bool isZero() const { return m_data.asString() == zero().asStringBytes(); }
+    bool isZero() const { return *this == zero(); }
     static FH32 const& zero();
 };
 
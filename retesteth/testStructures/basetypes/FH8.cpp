@@ -9,5 +9,5 @@ FH8 const& FH8::zero()
 
 FH8* FH8::copy() const
 {
-    return new FH8(asString());
+    return new FH8(*this);
 }
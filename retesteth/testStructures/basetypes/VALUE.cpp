@@ -7,7 +7,6 @@
 using namespace std;
 using namespace dev;
 using namespace test::teststruct;
-std::mutex g_cacheAccessMutexValue;
 
 namespace test::teststruct
 {
@@ -17,21 +16,53 @@ namespace test::teststruct
 //     if string is hex  check hexvalue 0x00000 leading zeros etc
 // check limit
 
+namespace
+{
+// Parse verified 0x prefixed hex of up to 64 digits
+dev::u256 parseU256Hex(string const& _s)
+{
+    dev::u256 ret = 0;
+    for (size_t i = 2; i < _s.size(); i++)
+    {
+        char const c = _s[i];
+        unsigned nibble;
+        if (c >= '0' && c <= '9')
+            nibble = c - '0';
+        else if (c >= 'a' && c <= 'f')
+            nibble = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F')
+            nibble = c - 'A' + 10;
+        else
+            throw test::UpwardsException("VALUE is not a hex string `" + _s + "`");
+        ret = (ret << 4) | nibble;
+    }
+    return ret;
+}
+}  // namespace
+
 VALUE::VALUE(dev::RLP const& _rlp)
 {
-    std::ostringstream stream;
-    stream << _rlp.toBytes();
-    auto const& str = stream.str();
-    m_prefixedZeroBytes = _countPrefixedBytes(str);
-    m_bigint = (str.size() > 64 + 2) || m_prefixedZeroBytes >= 1;
-    m_data = dev::bigint(str);
+    dev::bytesConstRef const data = _rlp.toBytesConstRef();
+    for (size_t i = 0; i + 1 < data.size() && data[i] == 0; i++)
+        m_prefixedZeroBytes++;
+    m_bigint = data.size() > 32 || m_prefixedZeroBytes >= 1;
+    if (m_bigint)
+    {
+        m_isU256 = false;
+        m_data = dev::fromBigEndian<dev::bigint>(data);
+    }
+    else
+        m_u256 = dev::fromBigEndian<dev::u256>(data);
 }
 
-VALUE::VALUE(dev::bigint const& _data) : m_data(_data) {}
+VALUE::VALUE(dev::bigint const& _data)
+{
+    _assign(_data);
+}
 
 VALUE::VALUE(int _data)
 {
-    m_data = dev::bigint(_data);
+    _assign(dev::bigint(_data));
 }
 
 VALUE::VALUE(string const& _data)
@@ -42,21 +73,128 @@ VALUE::VALUE(string const& _data)
 VALUE::VALUE(DataObject const& _data)
 {
     if (_data.type() == DataType::Integer)
-        m_data = _data.asInt();
+        _assign(dev::bigint(_data.asInt()));
     else
         _fromString(_data.asString(), _data.getKey());
 }
 
+VALUE& VALUE::operator=(VALUE const& _other)
+{
+    // Reference counter of the smart pointer base is not copied
+    if (this == &_other)
+        return *this;
+    m_isU256 = _other.m_isU256;
+    m_u256 = _other.m_u256;
+    bool const bigintReady = _other.m_bigintReady.ready();
+    if (!m_isU256 || bigintReady)
+        m_data = _other.m_data;
+    if (bigintReady)
+        m_bigintReady = _other.m_bigintReady;
+    else
+        m_bigintReady.reset();
+
+    // Take over the ready string and rlp form, the copy has the same value
+    if (_other.m_cache.ready())
+    {
+        m_dataStr = _other.m_dataStr;
+        m_bytesData = _other.m_bytesData;
+        m_cache = _other.m_cache;
+    }
+    else
+        m_cache.reset();
+    m_bigint = _other.m_bigint;
+    m_bigintEmpty = _other.m_bigintEmpty;
+    m_prefixedZeroBytes = _other.m_prefixedZeroBytes;
+    return *this;
+}
+
+VALUE* VALUE::copy() const
+{
+    if (!m_isU256)
+        return new VALUE(m_data);
+    VALUE* ret = new VALUE();
+    ret->m_u256 = m_u256;
+    return ret;
+}
+
+void VALUE::_assign(dev::bigint const& _data)
+{
+    static dev::bigint const c_maxU256 = dev::bigint(dev::u256(-1));
+    m_isU256 = !m_bigint && _data >= 0 && _data <= c_maxU256;
+    if (m_isU256)
+        m_u256 = dev::u256(_data);
+    else
+        m_data = _data;
+    m_bigintReady.reset();
+    m_cache.reset();
+}
+
+VALUE VALUE::operator+(VALUE const& _rhs) const
+{
+    if (m_bigint)
+        return VALUE(asBigInt() + _rhs.asBigInt());
+    VALUE ret(*this);
+    ret += _rhs;
+    return ret;
+}
+
+VALUE VALUE::operator-(VALUE const& _rhs) const
+{
+    if (m_bigint)
+        return VALUE(asBigInt() - _rhs.asBigInt());
+    VALUE ret(*this);
+    ret -= _rhs;
+    return ret;
+}
+
+VALUE& VALUE::operator+=(VALUE const& _rhs)
+{
+    if (m_isU256 && _rhs.m_isU256)
+    {
+        dev::u256 const sum = m_u256 + _rhs.m_u256;
+        if (sum >= m_u256)
+        {
+            m_u256 = sum;
+            m_bigintReady.reset();
+            m_cache.reset();
+            return *this;
+        }
+    }
+    _assign(asBigInt() + _rhs.asBigInt());
+    return *this;
+}
+
+VALUE& VALUE::operator-=(VALUE const& _rhs)
+{
+    if (m_isU256 && _rhs.m_isU256 && m_u256 >= _rhs.m_u256)
+    {
+        m_u256 -= _rhs.m_u256;
+        m_bigintReady.reset();
+        m_cache.reset();
+        return *this;
+    }
+    _assign(asBigInt() - _rhs.asBigInt());
+    return *this;
+}
+
+dev::bigint const& VALUE::asBigInt() const
+{
+    if (m_isU256)
+        m_bigintReady.initialize([this]() { m_data = dev::bigint(m_u256); });
+    return m_data;
+}
+
 void VALUE::_fromString(std::string const& _data, std::string const& _hintkey)
 {
     string const withoutKeyWord = verifyHexString(_data, _hintkey);
     if (withoutKeyWord.size())
     {
         m_bigint = true;
+        m_isU256 = false;
         m_data = dev::bigint(withoutKeyWord);
     }
     else
-        m_data = dev::bigint(_data);
+        m_u256 = parseU256Hex(_data);
 }
 
 string VALUE::verifyHexString(std::string const& _s, std::string const& _k) const
@@ -109,6 +247,8 @@ string VALUE::verifyHexString(std::string const& _s, std::string const& _k) cons
 
 string VALUE::asDecString() const
 {
+    if (m_isU256)
+        return m_u256.str(0, std::ios_base::dec);
     return m_data.str(0, std::ios_base::dec);
 }
 
@@ -126,12 +266,15 @@ dev::bytes const& VALUE::serializeRLP() const
 
 void VALUE::calculateCache() const
 {
-    std::lock_guard<std::mutex> lock(g_cacheAccessMutexValue);
-    if (m_dirty)
-    {
-        m_dirty = false;
+    m_cache.initialize([this]() {
+        if (m_isU256)
+        {
+            m_bytesData = dev::toCompactBigEndian(m_u256);
+            m_dataStr = m_bytesData.empty() ? "0x00" : dev::toHexPrefixed(m_bytesData);
+            return;
+        }
 
-        m_dataStr = m_data.str(0, std::ios_base::hex);
+        m_dataStr = asBigInt().str(0, std::ios_base::hex);
         if (m_dataStr.size() % 2 != 0)
             m_dataStr.insert(0, "0");
         test::strToLower(m_dataStr);
@@ -154,7 +297,7 @@ void VALUE::calculateCache() const
             m_bytesData = m_bigintEmpty ? test::sfromHex("") : test::sfromHex(m_dataStr);
             m_dataStr.insert(0, C_BIGINT_PREFIX);
         }
-    }
+    });
 }
 
 size_t VALUE::_countPrefixedBytes(std::string const& _str) const
@@ -1,4 +1,5 @@
 #pragma once
+#include "CacheFlag.h"
 #include <libdataobj/DataObject.h>
 #include <libdevcore/Common.h>
 #include <libdevcore/RLP.h>
@@ -18,52 +19,67 @@ struct VALUE : dataobject::GCP_SPointerBase
     VALUE(int);
     explicit VALUE(dataobject::DataObject const&);  // Does not require to move smart pointer here as this structure changes a lot
     explicit VALUE(std::string const&);
-    VALUE* copy() const { return new VALUE(m_data); }
+    VALUE(VALUE const& _other) : dataobject::GCP_SPointerBase() { *this = _other; }
+    VALUE& operator=(VALUE const& _other);
+    VALUE* copy() const;
 
-    bool operator<(long long _rhs) const { return m_data < _rhs; }
-    bool operator>(VALUE const& _rhs) const { return m_data > _rhs.asBigInt(); }
-    bool operator>=(VALUE const& _rhs) const { return m_data >= _rhs.asBigInt(); }
-    bool operator<(VALUE const& _rhs) const { return m_data < _rhs.asBigInt(); }
-    bool operator<=(VALUE const& _rhs) const { return m_data <= _rhs.asBigInt(); }
-    bool operator!=(VALUE const& _rhs) const { return m_data != _rhs.asBigInt(); }
-    bool operator==(VALUE const& _rhs) const { return m_data == _rhs.asBigInt(); }
+    bool operator<(long long _rhs) const { return m_isU256 ? (_rhs > 0 && m_u256 < dev::u256(_rhs)) : m_data < _rhs; }
+    bool operator>(VALUE const& _rhs) const { return _rhs < *this; }
+    bool operator>=(VALUE const& _rhs) const { return !(*this < _rhs); }
+    bool operator<(VALUE const& _rhs) const
+    {
+        return (m_isU256 && _rhs.m_isU256) ? m_u256 < _rhs.m_u256 : asBigInt() < _rhs.asBigInt();
+    }
+    bool operator<=(VALUE const& _rhs) const { return !(_rhs < *this); }
+    bool operator!=(VALUE const& _rhs) const { return !(*this == _rhs); }
+    bool operator==(VALUE const& _rhs) const
+    {
+        return (m_isU256 && _rhs.m_isU256) ? m_u256 == _rhs.m_u256 : asBigInt() == _rhs.asBigInt();
+    }
 
-    VALUE operator-(VALUE const& _rhs) const { return VALUE(m_data - _rhs.asBigInt()); }
-    VALUE operator-(long long  _rhs) const { return VALUE(m_data - _rhs); }
-    VALUE operator/(VALUE const& _rhs) const { return VALUE(m_data / _rhs.asBigInt()); }
-    VALUE operator/(long long  _rhs) const { return VALUE(m_data / _rhs); }
-    VALUE operator*(VALUE const& _rhs) const { return VALUE(m_data * _rhs.asBigInt()); }
-    VALUE operator*(long long  _rhs) const { return VALUE(m_data * _rhs); }
-    VALUE operator+(VALUE const& _rhs) const { return VALUE(m_data + _rhs.asBigInt()); }
-    VALUE operator+(long long  _rhs) const { return VALUE(m_data + _rhs); }
+    VALUE operator-(VALUE const& _rhs) const;
+    VALUE operator-(long long  _rhs) const { return VALUE(asBigInt() - _rhs); }
+    VALUE operator/(VALUE const& _rhs) const { return VALUE(asBigInt() / _rhs.asBigInt()); }
+    VALUE operator/(long long  _rhs) const { return VALUE(asBigInt() / _rhs); }
+    VALUE operator*(VALUE const& _rhs) const { return VALUE(asBigInt() * _rhs.asBigInt()); }
+    VALUE operator*(long long  _rhs) const { return VALUE(asBigInt() * _rhs); }
+    VALUE operator+(VALUE const& _rhs) const;
+    VALUE operator+(long long  _rhs) const { return VALUE(asBigInt() + _rhs); }
 
-    VALUE& operator+=(VALUE const& _rhs) { m_data += _rhs.asBigInt(); m_dirty = true; return *this; }
-    VALUE& operator+=(long long  _rhs) { m_data += _rhs; m_dirty = true; return *this; }
-    VALUE& operator-=(VALUE const& _rhs) { m_data -= _rhs.asBigInt(); m_dirty = true; return *this; }
-    VALUE& operator-=(long long  _rhs) { m_data -= _rhs; m_dirty = true; return *this; }
-    VALUE& operator/=(VALUE const& _rhs) { m_data /= _rhs.asBigInt(); m_dirty = true; return *this; }
-    VALUE& operator/=(long long  _rhs) { m_data /= _rhs; m_dirty = true; return *this; }
-    VALUE& operator*=(VALUE const& _rhs) { m_data *= _rhs.asBigInt(); m_dirty = true; return *this; }
-    VALUE& operator*=(long long  _rhs) { m_data *= _rhs; m_dirty = true; return *this; }
+    VALUE& operator+=(VALUE const& _rhs);
+    VALUE& operator+=(long long  _rhs) { _assign(asBigInt() + _rhs); return *this; }
+    VALUE& operator-=(VALUE const& _rhs);
+    VALUE& operator-=(long long  _rhs) { _assign(asBigInt() - _rhs); return *this; }
+    VALUE& operator/=(VALUE const& _rhs) { _assign(asBigInt() / _rhs.asBigInt()); return *this; }
+    VALUE& operator/=(long long  _rhs) { _assign(asBigInt() / _rhs); return *this; }
+    VALUE& operator*=(VALUE const& _rhs) { _assign(asBigInt() * _rhs.asBigInt()); return *this; }
+    VALUE& operator*=(long long  _rhs) { _assign(asBigInt() * _rhs); return *this; }
 
-    VALUE operator++(int) { m_data++; return *this; }
+    VALUE operator++(int) { _assign(asBigInt() + 1); return *this; }
 
     std::string const& asString() const;
     std::string asDecString() const;
-    dev::bigint const& asBigInt() const { return m_data; }
+    dev::bigint const& asBigInt() const;
     dev::bytes const& serializeRLP() const;
     bool isBigInt() const { return m_bigint; }
 
 private:
     VALUE() {}
     void _fromString(std::string const& _data, std::string const& _hintkey = std::string());
+    void _assign(dev::bigint const& _data);
     std::string verifyHexString(std::string const& _s, std::string const& _k = std::string()) const;
     void calculateCache() const;
     size_t _countPrefixedBytes(std::string const&) const;
-    dev::bigint m_data;
+
+    // Values that fit u256 (the most of them) are kept in fixed width inline storage
+    // m_data is the source for the rest (negative, >u256, bigint test cases) and filled on demand otherwise
+    bool m_isU256 = true;
+    dev::u256 m_u256 = 0;
+    mutable dev::bigint m_data;
+    CacheFlag m_bigintReady;
 
     // Optimizations
-    mutable bool m_dirty = true;
+    CacheFlag m_cache;
     mutable std::string m_dataStr;
     mutable dev::bytes m_bytesData;
 
@@ -15,13 +15,22 @@ void requireJsonFileStructure(DataObject const& _data)
         {{"name", {{DataType::String}, jsonField::Required}},
             {"socketType", {{DataType::String}, jsonField::Required}},
             {"socketAddress", {{DataType::String, DataType::Array}, jsonField::Required}},
+            {"t8nDaemon", {{DataType::String}, jsonField::Optional}},
+            {"t8nDaemonAllocDiff", {{DataType::Bool}, jsonField::Optional}},
+            {"t8nDaemonTimeout", {{DataType::Integer}, jsonField::Optional}},
             {"customCompilers", {{DataType::Object}, jsonField::Optional}},
             {"initializeTime", {{DataType::String}, jsonField::Optional}},
             {"tmpDir", {{DataType::String}, jsonField::Optional}},
             {"transactionsAsJson", {{DataType::Bool}, jsonField::Optional}},
+            {"t8nStdio", {{DataType::Bool}, jsonField::Optional}},
+            {"eofStdio", {{DataType::Bool}, jsonField::Optional}},
             {"checkLogsHash", {{DataType::Bool}, jsonField::Optional}},
             {"checkDifficulty", {{DataType::Bool}, jsonField::Optional}},
             {"calculateDifficulty", {{DataType::Bool}, jsonField::Optional}},
+            {"nativeDifficulty", {{DataType::Bool}, jsonField::Optional}},
+            {"nativeDifficultyToolCheck", {{DataType::Integer}, jsonField::Optional}},
+            {"nativeGenesisRoot", {{DataType::Bool}, jsonField::Optional}},
+            {"checkTrieRoots", {{DataType::Bool}, jsonField::Optional}},
             {"support1559", {{DataType::Bool}, jsonField::Optional}},
             {"supportBigint", {{DataType::Bool}, jsonField::Optional}},
             {"checkBasefee", {{DataType::Bool}, jsonField::Optional}},
@@ -115,6 +124,17 @@ void ClientConfigFile::parseSocketType(DataObject const& _data, string const& _s
                 " But file not found (" + m_pathToExecFile.string() + ")");
         if (fs::exists(cfgPath / m_pathToExecFile))
             m_pathToExecFile = cfgPath / m_pathToExecFile;
+
+        // Optional long living t8n server that accepts transition requests line by line
+        if (_data.count("t8nDaemon"))
+        {
+            m_pathToT8NDaemon = fs::path(_data.atKey("t8nDaemon").asString());
+            ETH_FAIL_REQUIRE_MESSAGE(fs::exists(m_pathToT8NDaemon) || fs::exists(cfgPath / m_pathToT8NDaemon),
+                _sErrorPath + "`t8nDaemon` must point to a t8n server cmd!" +
+                    " But file not found (" + m_pathToT8NDaemon.string() + ")");
+            if (fs::exists(cfgPath / m_pathToT8NDaemon))
+                m_pathToT8NDaemon = cfgPath / m_pathToT8NDaemon;
+        }
     }
 }
 
@@ -147,6 +167,23 @@ void ClientConfigFile::initWithData(DataObject const& _data)
     if (_data.count("calculateDifficulty"))
         m_calculateDifficulty = _data.atKey("calculateDifficulty").asBool();
 
+    m_nativeDifficulty = false;
+    if (_data.count("nativeDifficulty"))
+        m_nativeDifficulty = _data.atKey("nativeDifficulty").asBool();
+
+    // Prime, so the checked vectors do not follow the loops over the filler ranges
+    m_nativeDifficultyToolCheck = 101;
+    if (_data.count("nativeDifficultyToolCheck"))
+        m_nativeDifficultyToolCheck = _data.atKey("nativeDifficultyToolCheck").asInt();
+
+    m_nativeGenesisRoot = false;
+    if (_data.count("nativeGenesisRoot"))
+        m_nativeGenesisRoot = _data.atKey("nativeGenesisRoot").asBool();
+
+    m_checkTrieRoots = false;
+    if (_data.count("checkTrieRoots"))
+        m_checkTrieRoots = _data.atKey("checkTrieRoots").asBool();
+
     m_calculateBasefee = false;
     if (_data.count("calculateBasefee"))
         m_calculateBasefee = _data.atKey("calculateBasefee").asBool();
@@ -167,6 +204,27 @@ void ClientConfigFile::initWithData(DataObject const& _data)
     if (_data.count("transactionsAsJson"))
         m_transactionsAsJson = _data.atKey("transactionsAsJson").asBool();
 
+    m_t8nStdio = false;
+    if (_data.count("t8nStdio"))
+        m_t8nStdio = _data.atKey("t8nStdio").asBool();
+
+    m_eofStdio = false;
+    if (_data.count("eofStdio"))
+        m_eofStdio = _data.atKey("eofStdio").asBool();
+
+    m_t8nDaemonAllocDiff = false;
+    if (_data.count("t8nDaemonAllocDiff"))
+        m_t8nDaemonAllocDiff = _data.atKey("t8nDaemonAllocDiff").asBool();
+
+    m_t8nDaemonTimeout = 600;
+    if (_data.count("t8nDaemonTimeout"))
+    {
+        int const timeout = _data.atKey("t8nDaemonTimeout").asInt();
+        if (timeout <= 0)
+            ETH_FAIL_MESSAGE(sErrorPath + "`t8nDaemonTimeout` must be a positive number of seconds!");
+        m_t8nDaemonTimeout = timeout;
+    }
+
     m_continueOnErrors = false;
     if (_data.count("continueOnErrors"))
         m_continueOnErrors = _data.atKey("continueOnErrors").asBool();
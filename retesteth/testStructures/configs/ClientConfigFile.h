@@ -36,6 +36,10 @@ struct ClientConfigFile : GCP_SPointerBase
 
     bool checkDifficulty() const { return m_checkDifficulty; }
     bool calculateDifficulty() const { return m_calculateDifficulty; }
+    bool nativeDifficulty() const { return m_nativeDifficulty; }
+    size_t nativeDifficultyToolCheck() const { return m_nativeDifficultyToolCheck; }
+    bool nativeGenesisRoot() const { return m_nativeGenesisRoot; }
+    bool checkTrieRoots() const { return m_checkTrieRoots; }
 
     bool checkBasefee() const { return m_checkBasefee; }
     bool calculateBasefee() const { return m_calculateBasefee; }
@@ -44,12 +48,17 @@ struct ClientConfigFile : GCP_SPointerBase
     bool support1559() const { return m_support1559; }
     bool supportBigint() const { return m_supportBigint; }
     bool transactionsAsJson() const { return m_transactionsAsJson; }
+    bool t8nStdio() const { return m_t8nStdio; }
+    bool eofStdio() const { return m_eofStdio; }
+    bool t8nDaemonAllocDiff() const { return m_t8nDaemonAllocDiff; }
+    size_t t8nDaemonTimeout() const { return m_t8nDaemonTimeout; }
     bool continueOnErrors() const { return m_continueOnErrors; }
 
     std::map<std::string, std::string> const& exceptions() const { return m_exceptions; }
     std::map<std::string, std::string> const& fieldreplace() const { return m_fieldRaplce; }
     boost::filesystem::path const& path() const { return m_configFilePath; }
     boost::filesystem::path const& shell() const { return m_pathToExecFile; }
+    boost::filesystem::path const& t8nDaemon() const { return m_pathToT8NDaemon; }
 
 
 private:
@@ -69,11 +78,19 @@ private:
     bool m_checkLogsHash;                    ///< Enable logsHash verification
     bool m_checkDifficulty;                  ///< Enable difficulty verification
     bool m_calculateDifficulty;              ///< Retesteth calculate difficulty for the client
+    bool m_nativeDifficulty;                 ///< Retesteth fills DifficultyTests vectors of known forks itself
+    size_t m_nativeDifficultyToolCheck;      ///< Ask the client for every Nth native difficulty vector, 0 to never ask
+    bool m_nativeGenesisRoot;                ///< Retesteth calculates genesis stateRoot without running the tool
+    bool m_checkTrieRoots;                   ///< Verify tool state, transactions and withdrawals roots by retesteth
     bool m_checkBasefee;                     ///< Enable basefee verifivation
     bool m_calculateBasefee;                 ///< Retesteth calculate basefee value
     bool m_support1559;                      ///< Support EIP1559 headers
     bool m_supportBigint;                    ///< Support malicious oversize data encodings for tests
     bool m_transactionsAsJson;               ///< Make T8N txs file as json not rlp
+    bool m_t8nStdio;                         ///< Pass T8N inputs via stdin and read outputs from stdout
+    bool m_eofStdio;                         ///< Stream EOF codes line by line to one `eof` tool process per fork
+    bool m_t8nDaemonAllocDiff;               ///< T8N daemon caches states and exchanges only changed accounts
+    size_t m_t8nDaemonTimeout;               ///< Seconds to wait for a T8N daemon response before calling the tool
     bool m_continueOnErrors;                 ///< Continue test run on error
     size_t m_initializeTime;                 ///< Time to start the instance
     std::vector<FORK> m_forks;               ///< Allowed forks as network name
@@ -85,6 +102,7 @@ private:
     // Additional values
     boost::filesystem::path m_configFilePath;  ///< Path to the config file
     boost::filesystem::path m_pathToExecFile;  ///< Path to cmd that runs the client instance (for t8ntool)
+    boost::filesystem::path m_pathToT8NDaemon; ///< Path to persistent t8n server cmd (empty: run tool per block)
 private:
     // Optimisations
     mutable std::set<FORK> m_forkProgressionAsSet;
@@ -27,14 +27,16 @@ BlockchainTestInFiller::BlockchainTestInFiller(spDataObject& _data)
         m_name = _data->getKey();
         if (_data->count("_info"))
             m_info = spInfoIncomplete(new InfoIncomplete(MOVE(_data, "_info")));
+        precompileFillerCodes(_data.getCContent());
         convertDecStateToHex((*_data).atKeyPointerUnsafe("pre"));
         m_pre = spState(new State(MOVE(_data, "pre")));
         m_hasEmptyAccounts = checkEmptyAccounts(m_pre);
 
         // Prepare nonce map for transaction 'auto' nonce parsing
         NonceMap nonceMap;
-        for (auto const& acc : m_pre->accounts())
-            nonceMap.emplace(acc.first.asString(), spVALUE(new VALUE(acc.second->nonce().asBigInt())));
+        m_pre->forEachAccount([&nonceMap](FH20 const& _address, spAccountBase const& _acc) {
+            nonceMap.emplace(_address.asString(), spVALUE(new VALUE(_acc->nonce().asBigInt())));
+        });
         // nonce map
 
         m_sealEngine = SealEngine::NoProof;
@@ -1,6 +1,7 @@
 #pragma once
 #include "AccountBase.h"
 #include <libdataobj/DataObject.h>
+#include <functional>
 
 namespace test
 {
@@ -8,7 +9,13 @@ namespace teststruct
 {
 struct StateBase : GCP_SPointerBase
 {
-    std::map<FH20, spAccountBase> const& accounts() const { return m_accounts; }
+    // Visit accounts in address order
+    typedef std::function<void(FH20 const&, spAccountBase const&)> AccountVisitor;
+    virtual void forEachAccount(AccountVisitor const& _visit) const
+    {
+        for (auto const& [address, acc] : m_accounts)
+            _visit(address, acc);
+    }
     virtual spDataObject asDataObject() const = 0;
     virtual ~StateBase() {}
 
@@ -2,6 +2,12 @@
 #include <retesteth/EthChecks.h>
 
 using namespace std;
+namespace
+{
+// Bounds the lookup chain through parent states, deeper overlays are stored flat
+size_t const c_maxStateOverlayDepth = 16;
+}  // namespace
+
 namespace test::teststruct
 {
 
@@ -15,6 +21,42 @@ State::State(std::map<FH20, spAccountBase>& _accList)
     }
 }
 
+State::State(spState const& _parent, std::map<FH20, spAccountBase>& _changed, std::set<FH20> const& _deleted)
+{
+    for (auto const& el : _changed)
+    {
+        ETH_ERROR_REQUIRE_MESSAGE(el.second->type() == AccountType::FullAccount, "State::State(parent) provided account type is not of a FullAccount type!");
+    }
+
+    if (_parent->m_depth + 1 >= c_maxStateOverlayDepth)
+    {
+        _parent->collectAccounts(m_accounts);
+        for (auto const& addr : _deleted)
+            m_accounts.erase(addr);
+        for (auto const& el : _changed)
+            m_accounts[el.first] = el.second;
+        return;
+    }
+
+    m_parent = _parent;
+    m_depth = _parent->m_depth + 1;
+    m_accounts = _changed;
+    m_accountCount = _parent->accountCount();
+    for (auto const& el : m_accounts)
+    {
+        if (!_parent->hasAccount(el.first))
+            m_accountCount++;
+    }
+    for (auto const& addr : _deleted)
+    {
+        if (!m_accounts.count(addr) && _parent->hasAccount(addr))
+        {
+            m_deleted.emplace(addr);
+            m_accountCount--;
+        }
+    }
+}
+
 State::State(spDataObjectMove _data)
 {
     spDataObject data = _data.getPointer();
@@ -38,39 +80,122 @@ State::State(spDataObjectMove _data)
     }
 }
 
+AccountBase const* State::findAccount(FH20 const& _address) const
+{
+    State const* state = this;
+    while (state)
+    {
+        auto const it = state->m_accounts.find(_address);
+        if (it != state->m_accounts.end())
+            return &it->second.getCContent();
+        if (state->m_deleted.count(_address))
+            return nullptr;
+        state = state->m_parent.isEmpty() ? nullptr : &state->m_parent.getCContent();
+    }
+    return nullptr;
+}
+
+void State::collectAccounts(std::map<FH20, spAccountBase>& _accounts) const
+{
+    forEachAccount([&_accounts](FH20 const& _address, spAccountBase const& _acc) { _accounts.emplace_hint(_accounts.end(), _address, _acc); });
+}
+
+void State::forEachAccount(AccountVisitor const& _visit) const
+{
+    forEachAccountFrom(FH20::zero(), [&_visit](FH20 const& _address, spAccountBase const& _acc) {
+        _visit(_address, _acc);
+        return true;
+    });
+}
+
+void State::forEachAccountFrom(FH20 const& _from, AccountRangeVisitor const& _visit) const
+{
+    if (m_parent.isEmpty())
+    {
+        for (auto it = m_accounts.lower_bound(_from); it != m_accounts.end(); it++)
+        {
+            if (!_visit(it->first, it->second))
+                return;
+        }
+        return;
+    }
+
+    // Merge the sorted account maps of the chain, the nearest state that changed or deleted an address wins
+    std::vector<State const*> chain;
+    for (State const* state = this; state; state = state->m_parent.isEmpty() ? nullptr : &state->m_parent.getCContent())
+        chain.emplace_back(state);
+    std::vector<std::map<FH20, spAccountBase>::const_iterator> positions;
+    for (State const* state : chain)
+        positions.emplace_back(state->m_accounts.lower_bound(_from));
+
+    while (true)
+    {
+        FH20 const* next = nullptr;
+        for (size_t i = 0; i < chain.size(); i++)
+        {
+            if (positions.at(i) != chain.at(i)->m_accounts.end() && (!next || positions.at(i)->first < *next))
+                next = &positions.at(i)->first;
+        }
+        if (!next)
+            break;
+
+        FH20 const address = *next;
+        spAccountBase const* visible = nullptr;
+        bool resolved = false;
+        for (size_t i = 0; i < chain.size(); i++)
+        {
+            auto& pos = positions.at(i);
+            bool const holds = pos != chain.at(i)->m_accounts.end() && pos->first == address;
+            if (!resolved && holds)
+            {
+                visible = &pos->second;
+                resolved = true;
+            }
+            else if (!resolved && chain.at(i)->m_deleted.count(address))
+                resolved = true;
+            if (holds)
+                pos++;
+        }
+        if (visible && !_visit(address, *visible))
+            return;
+    }
+}
+
 State::Account const& State::getAccount(FH20 const& _address) const
 {
-    assert(m_accounts.count(_address));
-    return dynamic_cast<State::Account const&>(m_accounts.at(_address).getCContent());
+    AccountBase const* acc = findAccount(_address);
+    assert(acc);
+    return dynamic_cast<State::Account const&>(*acc);
 }
 
 bool State::hasAccount(State::Account const& _accaunt) const
 {
-    return m_accounts.count(_accaunt.address());
+    return findAccount(_accaunt.address()) != nullptr;
 }
 
 bool State::hasAccount(FH20 const& _address) const
 {
-    return m_accounts.count(_address);
+    return findAccount(_address) != nullptr;
 }
 
 spDataObject State::asDataObject() const
 {
     spDataObject data = sDataObject(DataType::Object);
-    for (auto const& [accKey, acc] : m_accounts)
-    {
-        (*data).atKeyPointer(accKey.asString()) = acc->asDataObject();
-    }
+    forEachAccount([&data](FH20 const& _address, spAccountBase const& _acc) {
+        (*data).atKeyPointer(_address.asString()) = _acc->asDataObject();
+    });
     return data;
 }
 
 void State::addAccount(spAccountBase _acc)
 {
-    if (m_accounts.contains(_acc->address()))
+    if (hasAccount(_acc->address()))
     {
         ETH_ERROR_MESSAGE("State::addAccount: State has dublicate key: `" + _acc->address().asString() + "`");
     }
     m_accounts.emplace(_acc->address(), _acc);
+    m_deleted.erase(_acc->address());
+    m_accountCount++;
 }
 
 }  // namespace teststruct
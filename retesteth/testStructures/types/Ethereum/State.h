@@ -1,6 +1,7 @@
 #pragma once
 #include "Base/StateBase.h"
 #include <libdataobj/DataObject.h>
+#include <set>
 
 namespace test::teststruct
 {
@@ -19,16 +20,36 @@ public:
     State(spDataObjectMove);
     State(std::map<FH20, spAccountBase>&);
 
-    std::map<FH20, spAccountBase> const& accounts() const { return m_accounts; }
+    // Copy on write state of a block: keeps only accounts changed or deleted compared to _parent
+    // and falls back to _parent for the rest. Unchanged account objects are shared between states
+    State(GCP_SPointer<State> const& _parent, std::map<FH20, spAccountBase>& _changed, std::set<FH20> const& _deleted);
+
     Account const& getAccount(FH20 const& _address) const;
     bool hasAccount(Account const& _account) const;
     bool hasAccount(FH20 const& _address) const;
     void addAccount(spAccountBase _acc);
+    size_t accountCount() const { return m_parent.isEmpty() ? m_accounts.size() : m_accountCount; }
+
+    // Visit accounts in address order, walking the overlay chain without building a flat copy
+    void forEachAccount(AccountVisitor const& _visit) const override;
+
+    // Visit accounts in address order starting at _from, stops when _visit returns false
+    typedef std::function<bool(FH20 const&, spAccountBase const&)> AccountRangeVisitor;
+    void forEachAccountFrom(FH20 const& _from, AccountRangeVisitor const& _visit) const;
+    bool isOverlay() const { return !m_parent.isEmpty(); }
 
     spDataObject asDataObject() const override;
 
 private:
     State() {}
+    AccountBase const* findAccount(FH20 const& _address) const;
+    void collectAccounts(std::map<FH20, spAccountBase>& _accounts) const;
+
+    // Overlay part, m_accounts holds changed accounts when m_parent is set
+    GCP_SPointer<State> m_parent;
+    std::set<FH20> m_deleted;
+    size_t m_depth = 0;
+    size_t m_accountCount = 0;
 
 public:
     // Ethereum account description
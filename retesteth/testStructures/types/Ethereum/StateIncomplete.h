@@ -8,6 +8,7 @@ namespace test::teststruct
 struct StateIncomplete : StateBase
 {
     StateIncomplete(spDataObjectMove);
+    std::map<FH20, spAccountBase> const& accounts() const { return m_accounts; }
     void correctMiningReward(FH20 const& _coinbase, VALUE const& _reward);
     spDataObject asDataObject() const override;
 
@@ -4,6 +4,7 @@
 #include <libdevcrypto/Common.h>
 #include <retesteth/testStructures/Common.h>
 #include <retesteth/helpers/TestOutputHelper.h>
+#include <retesteth/helpers/TestProfiler.h>
 
 using namespace std;
 using namespace test;
@@ -74,6 +75,7 @@ void Transaction::makeSignature(DataObject const& _data)
 
 void Transaction::buildVRS()
 {
+    ProfileScope profile(ProfilePhase::SignTransactions);
     const dev::h256 hash = buildVRSHash();
     const dev::Secret secret(m_secretKey->asString());
     dev::Signature sig = dev::sign(secret, hash);
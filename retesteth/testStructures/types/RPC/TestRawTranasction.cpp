@@ -52,4 +52,23 @@ string const& TestRawTransaction::error() const
     }
 }
 
+spDataObject TestRawTransaction::asDataObject() const
+{
+    spDataObject out;
+    (*out)["result"] = m_result;
+
+    spDataObject tr;
+    (*tr)["sender"] = m_sender->asString();
+    (*tr)["hash"] = m_trHash->asString();
+    (*tr)["intrinsicGas"] = m_intrinsicGas->asString();
+    if (m_rejectedTransactions.size() > 0)
+    {
+        (*tr)["error"] = error();
+        (*out)["rejectedTransactions"].addArrayObject(tr);
+    }
+    else
+        (*out)["acceptedTransactions"].addArrayObject(tr);
+    return out;
+}
+
 }  // namespace teststruct
@@ -15,6 +15,8 @@ struct TestRawTransaction : MineBlocksResult
     FH32 const& trhash() const { return m_trHash; }
     VALUE const& intrinsicGas() const { return m_intrinsicGas; }
     std::string const& error() const;
+    // Same structure as the RPC response the object is constructed from
+    spDataObject asDataObject() const;
 
 private:
     spFH20 m_sender;
@@ -20,3 +20,13 @@ void TransactionInGeneralSection::assignTransactionLabel(string const& _label)
 {
     m_tr.getContent().setDataLabel(_label);
 }
+
+TransactionInGeneralSection TransactionInGeneralSection::detachedCopy() const
+{
+    TransactionInGeneralSection copy(*this);
+    copy.m_tr = readTransaction(m_tr->getRawBytes());
+    (*copy.m_tr).setSecret(m_tr->getSecret());
+    (*copy.m_tr).setDataLabel(m_tr->dataLabel());
+    (*copy.m_tr).setDataRawPreview(m_tr->dataRawPreview());
+    return copy;
+}
@@ -26,6 +26,9 @@ struct TransactionInGeneralSection
     void assignTransactionLabel(std::string const& _label);
     void assignTransactionHash(FH32 const& _hash) { m_reportedHash = _hash; }
 
+    // Copy that does not share the transaction object (chainID is modified per fork), to execute on another thread
+    TransactionInGeneralSection detachedCopy() const;
+
 private:
     spTransaction m_tr;
     FH32 m_reportedHash = FH32::zero();
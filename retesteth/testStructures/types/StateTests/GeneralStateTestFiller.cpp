@@ -120,6 +120,7 @@ StateTestInFiller::StateTestInFiller(spDataObject& _data)
         if (_data->count("solidity"))
             solidityCode = test::compiler::compileSolidity(_data->atKey("solidity").asString());
 
+        precompileFillerCodes(_data.getCContent());
         convertDecStateToHex((*_data).atKeyPointerUnsafe("pre"), solidityCode); // "Pre" section
 
         m_pre = spState(new State(MOVE(_data, "pre")));
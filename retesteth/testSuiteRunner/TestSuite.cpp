@@ -23,9 +23,13 @@
 #include <retesteth/EthChecks.h>
 #include <retesteth/ExitHandler.h>
 #include <retesteth/Options.h>
+#include <retesteth/helpers/FillerHashIndex.h>
+#include <retesteth/helpers/TestCostCache.h>
 #include <retesteth/helpers/TestHelper.h>
 #include <retesteth/helpers/TestOutputHelper.h>
+#include <retesteth/helpers/TestProfiler.h>
 #include <retesteth/session/Session.h>
+#include <retesteth/session/ToolBackend/GenesisRootCache.h>
 #include <retesteth/session/ThreadManager.h>
 #include <retesteth/testSuiteRunner/TestSuite.h>
 #include <retesteth/testSuites/TestFixtures.h>
@@ -144,8 +148,14 @@ void TestSuite::runAllTestsInFolder(string const& _testFolder) const
         if (RPCSession::isRunningTooLong() || TestChecker::isTimeConsumingTest(_testFolder.c_str()))
             RPCSession::restartScripts(true);
 
+        // Start the longest tests first so the workers finish at about the same time
+        vector<fs::path> orderedFillers = testFillers;
+        if (Options::get().threadCount > 1)
+            TestCostCache::get().orderLongestFirst(orderedFillers);
+
+        prepareTestFolder(_testFolder, testFillers);
         testOutput.initTest(testFillers.size());
-        for (auto const& testFillerPath : testFillers)
+        for (auto const& testFillerPath : orderedFillers)
         {
             if (ExitHandler::receivedExitSignal())
                 break;
@@ -159,10 +169,19 @@ void TestSuite::runAllTestsInFolder(string const& _testFolder) const
             if (ExitHandler::receivedExitSignal())
                 break;
 
-            auto job = [this, &_testFolder, &testFillerPath]() { executeTest(_testFolder, testFillerPath); };
+            auto job = [this, &_testFolder, &testFillerPath]() {
+                dev::Timer timer;
+                ProfileScope profile(ProfilePhase::Test, testFillerPath.filename().string());
+                executeTest(_testFolder, testFillerPath);
+                if (!ExitHandler::receivedExitSignal())
+                    TestCostCache::get().record(testFillerPath, timer.elapsed());
+            };
             ThreadManager::addTask(job);
         }
         ThreadManager::joinThreads();
+        TestCostCache::get().save();
+        FillerHashIndex::get().save();
+        toolimpl::GenesisRootCache::get().save();
         testOutput.finishTest();
     };
     runFunctionForAllClients(thisPart);
@@ -137,6 +137,14 @@ protected:
     // each test suite.
     virtual FillerPath suiteFillerFolder() const = 0;
 
+    // Called for each client config before the tests of _testFolder are queued to the threads
+    // A suite can do work here that is cheaper for the whole folder at once than for each test
+    virtual void prepareTestFolder(std::string const& _testFolder, std::vector<boost::filesystem::path> const& _fillers) const
+    {
+        (void)_testFolder;
+        (void)_fillers;
+    }
+
     mutable std::string m_fillerPathAdd;
 
 private:
@@ -1,8 +1,10 @@
 #include "TestSuiteHelperFunctions.h"
 #include "Options.h"
 #include <retesteth/EthChecks.h>
+#include <retesteth/helpers/FillerHashIndex.h>
 #include <retesteth/helpers/TestHelper.h>
 #include <retesteth/helpers/TestOutputHelper.h>
+#include <retesteth/helpers/TestProfiler.h>
 #include <retesteth/testSuiteRunner/TestSuite.h>
 #include <libdevcore/CommonIO.h>
 
@@ -15,6 +17,7 @@ namespace test::testsuite
 {
 TestFileData readFillerTestFile(fs::path const& _testFileName)
 {
+    ProfileScope profile(ProfilePhase::ParseFiller);
     // Legacy hash validation require to sort json data upon load, thats the old algo used to calculate hash
     // Avoid time consuming legacy tests hash validation if there is no --checkhash option
     bool isLegacy = Options::isLegacyConstantinople();
@@ -60,6 +63,13 @@ TestFileData readFillerTestFile(fs::path const& _testFileName)
         return testData;
     }
 
+    // Unchanged filler, no need to print and hash the data again
+    if (!test::Options::get().showhash && FillerHashIndex::get().find(_testFileName, testData.hash))
+    {
+        testData.hashCalculated = true;
+        return testData;
+    }
+
     string const srcString = testData.data->asJson(0, false);
     if (test::Options::get().showhash)
     {
@@ -81,6 +91,7 @@ TestFileData readFillerTestFile(fs::path const& _testFileName)
     }
     testData.hash = sha3(srcString);
     testData.hashCalculated = true;
+    FillerHashIndex::get().record(_testFileName, testData.hash);
     return testData;
 }
 
@@ -1,5 +1,6 @@
 #include "EthChecks.h"
 #include "Options.h"
+#include <retesteth/helpers/FillerHashIndex.h>
 #include <retesteth/helpers/TestHelper.h>
 #include "TestSuiteHelperFunctions.h"
 //#include <libdevcore/CommonIO.h>
@@ -44,7 +45,11 @@ bool checkFillerHash(fs::path const& _compiledTest, fs::path const& _sourceTest)
     bool isTestOutdated = false;
     ETH_DC_MESSAGE(DC::TESTLOG, string("Check `") + _compiledTest.c_str() + "` hash");
     ETH_DC_MESSAGE(DC::TESTLOG, string("SrcFile `") + _sourceTest.c_str() + "`");
-    TestFileData fillerData = readFillerTestFile(_sourceTest);
+
+    // Only the hash is needed here, the filler is parsed if it is not in the index
+    TestFileData fillerData;
+    if (Options::get().showhash || !FillerHashIndex::get().find(_sourceTest, fillerData.hash))
+        fillerData = readFillerTestFile(_sourceTest);
 
     // If no hash calculated, skip the hash check
     if (!fillerData.hashCalculated)
@@ -1,5 +1,6 @@
 #include <retesteth/helpers/TestHelper.h>
 #include <retesteth/helpers/TestOutputHelper.h>
+#include <retesteth/helpers/TestProfiler.h>
 #include "TestSuiteHelperFunctions.h"
 #include "testSuiteRunner/TestSuite.h"
 #include <Options.h>
@@ -76,6 +77,7 @@ void updatePythonTestInfo(TestFileData& _testData, fs::path const& _pythonFiller
             addClientInfoIfUpdate(output, _pythonFiller, _testData.hash, outputTestFilePath);
         if (update)
         {
+            ProfileScope profile(ProfilePhase::WriteOutput);
             (*output).performModifier(mod_sortKeys, DataObject::ModifierOption::NONRECURSIVE);
             writeFile(outputTestFilePath, asBytes(output->asJson()));
         }
@@ -224,6 +226,7 @@ void TestSuite::_fillCopier(
     ETH_DC_MESSAGE(DC::TESTLOG, " TO " + _outputTestFilePath.path().string());
     assert(_fillerTestFilePath.string() != _outputTestFilePath.path().string());
     addClientInfoIfUpdate(_testData.data, _fillerTestFilePath, _testData.hash, _outputTestFilePath.path());
+    ProfileScope profile(ProfilePhase::WriteOutput);
     writeFile(_outputTestFilePath.path(), asBytes(_testData.data->asJson()));
     ETH_FAIL_REQUIRE_MESSAGE(
         boost::filesystem::exists(_outputTestFilePath.path().string()), "Error when copying the test file!");
@@ -253,6 +256,7 @@ bool TestSuite::_fillJsonYml(TestFileData& _testData, fs::path const& _fillerTes
                 addClientInfoIfUpdate(output, _fillerTestFilePath, _testData.hash, _outputTestFilePath.path());
             if (update)
             {
+                ProfileScope profile(ProfilePhase::WriteOutput);
                 (*output).performModifier(mod_sortKeys, DataObject::ModifierOption::NONRECURSIVE);
                 writeFile(_outputTestFilePath.path(), asBytes(output->asJson()));
             }
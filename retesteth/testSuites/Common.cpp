@@ -288,13 +288,12 @@ spDataObject storageDiff(Storage const& _pre, Storage const& _post)
 spDataObject stateDiff(State const& _pre, State const& _post)
 {
     spDataObject res(new DataObject(DataType::Object));
-    for (auto const& postAcc : _post.accounts())
-    {
-        if (_pre.hasAccount(postAcc.first))
+    _post.forEachAccount([&](FH20 const& _address, spAccountBase const& _postAcc) {
+        if (_pre.hasAccount(_address))
         {
             // check for updates
-            auto const& accPre = _pre.getAccount(postAcc.first);
-            auto const& accPost = postAcc.second;
+            auto const& accPre = _pre.getAccount(_address);
+            auto const& accPost = _postAcc;
 
             auto const& preBalance = accPre.balance();
             auto const& postBalance = accPost->balance();
@@ -302,7 +301,7 @@ spDataObject stateDiff(State const& _pre, State const& _post)
             {
                 auto const msg = preBalance.asString() + " -> " + postBalance.asString() + " (" +
                                  preBalance.asDecString() + " -> " + postBalance.asDecString() + ")";
-                (*res)[postAcc.first.asString()][c_balance] = msg;
+                (*res)[_address.asString()][c_balance] = msg;
             }
 
             auto const& preNonce = accPre.nonce();
@@ -311,23 +310,23 @@ spDataObject stateDiff(State const& _pre, State const& _post)
             {
                 auto const msg = preNonce.asString() + " -> " + postNonce.asString() + " (" +
                                  preNonce.asDecString() + " -> " + postNonce.asDecString() + ")";
-                (*res)[postAcc.first.asString()][c_nonce] = msg;
+                (*res)[_address.asString()][c_nonce] = msg;
             }
 
             auto const& preCode = accPre.code();
             auto const& postCode = accPost->code();
             if (preCode != postCode)
-                (*res)[postAcc.first.asString()][c_code] = preCode.asString() + " -> " + postCode.asString();
+                (*res)[_address.asString()][c_code] = preCode.asString() + " -> " + postCode.asString();
 
             auto const storageDiffRes = storageDiff(accPre.storage(), accPost->storage());
             if (storageDiffRes->getSubObjects().size())
-                (*res)[postAcc.first.asString()].atKeyPointer(c_storage) = storageDiffRes;
+                (*res)[_address.asString()].atKeyPointer(c_storage) = storageDiffRes;
         }
         else
         {
             // this is new account
-            string const key = "NEW: " + postAcc.first.asString();
-            (*res).atKeyPointer(key) = postAcc.second->asDataObject()->copy();
+            string const key = "NEW: " + _address.asString();
+            (*res).atKeyPointer(key) = _postAcc->asDataObject()->copy();
 
             // Print dec values
             VALUE balance((*res).atKey(key).atKey(c_balance));
@@ -340,16 +339,15 @@ spDataObject stateDiff(State const& _pre, State const& _post)
                 el.getContent().setString(val.asString() + " (" + val.asDecString() + ")");
             }
         }
-    }
-    for (auto const& preAcc : _pre.accounts())
-    {
-        if (!_post.hasAccount(preAcc.first))
+    });
+    _pre.forEachAccount([&](FH20 const& _address, spAccountBase const&) {
+        if (!_post.hasAccount(_address))
         {
             // this is deleted account
-            spDataObject deleted(new DataObject(string("DELETED: ") + preAcc.first.asString()));
+            spDataObject deleted(new DataObject(string("DELETED: ") + _address.asString()));
             (*res).addSubObject(deleted);
         }
-    }
+    });
     return res;
 }
 
@@ -45,6 +45,7 @@ struct StateTooBig : UpwardsException
 {
     StateTooBig() : UpwardsException("StateTooBig") {}
 };
+// The returned state may be shared with the session's chain, do not modify it
 spState getRemoteState(test::session::SessionInterface& _session);
 
 // Check that test has data object
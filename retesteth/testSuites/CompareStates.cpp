@@ -1,6 +1,7 @@
 #include "Common.h"
 #include <retesteth/Options.h>
 #include <retesteth/helpers/TestOutputHelper.h>
+#include <retesteth/helpers/TestProfiler.h>
 using namespace std;
 using namespace test::debug;
 using namespace test::session;
@@ -10,46 +11,198 @@ namespace test
 
 CompareResult compareAccounts(AccountBase const& _expectAccount, State::Account const& _remoteAccount);
 
-State::Account remoteGetAccount(SessionInterface& _session, VALUE const& _bNumber, VALUE const& _trIndex, FH20 const& _account)
+namespace
 {
-    // TODO make sp here. do not copy returned data
-    // Read the returned memory and put it in the account
-    spVALUE balance = _session.eth_getBalance(_account, _bNumber);
-    spVALUE nonce = _session.eth_getTransactionCount(_account, _bNumber);
-    spBYTES code = _session.eth_getCode(_account, _bNumber);
+// Remote storage is read by pages, accounts by packs in one JSON-RPC batch if the client supports it
+size_t const c_storagePageSize = 256;
+size_t const c_accountRangeSize = 256;
+size_t const c_accountBatchSize = 100;
+size_t const c_pipelineWindow = 16;
+typedef std::function<void(size_t, State::Account const&)> AccountCallback;
 
+// Read storage pages starting from _beginHash, a zero hash is the first page
+void remoteGetStorage(SessionInterface& _session, VALUE const& _bNumber, VALUE const& _trIndex, FH20 const& _account,
+    FH32 const& _beginHash, Storage& _storage)
+{
+    // Always read at least one page, the end of storage is known only from the returned nextKey
     bool hasStorage = true;
-    FH32 beginHash = FH32::zero();
-    spStorage tmpStorage = spStorage(new Storage(DataObject(DataType::Object)));
+    FH32 beginHash = _beginHash;
     size_t safety = 500;
     while (hasStorage && --safety)
     {
-        // Read storage from remote account by 20 records at a time
-        DebugStorageRangeAt res(_session.debug_storageRangeAt(_bNumber, _trIndex, _account, beginHash, 20));
+        DebugStorageRangeAt res(_session.debug_storageRangeAt(_bNumber, _trIndex, _account, beginHash, c_storagePageSize));
         if (res.nextKey().isZero())
             hasStorage = false;
         else
             beginHash = res.nextKey();
-        (*tmpStorage).merge(res.storage());
+        _storage.merge(res.storage());
     }
     if (safety == 0)
         ETH_ERROR_MESSAGE("remoteGetAccount::DebugStorageRangeAt seems like an endless loop!");
+}
+
+State::Account remoteGetAccount(SessionInterface& _session, VALUE const& _bNumber, VALUE const& _trIndex, FH20 const& _account)
+{
+    // TODO make sp here. do not copy returned data
+    // Read the returned memory and put it in the account
+    spVALUE balance = _session.eth_getBalance(_account, _bNumber);
+    spVALUE nonce = _session.eth_getTransactionCount(_account, _bNumber);
+    spBYTES code = _session.eth_getCode(_account, _bNumber);
+
+    spStorage tmpStorage = spStorage(new Storage(DataObject(DataType::Object)));
+    remoteGetStorage(_session, _bNumber, _trIndex, _account, FH32::zero(), tmpStorage.getContent());
     return State::Account(_account, balance, nonce, code, tmpStorage);
 }
 
+// Same conversions as RPCImpl does for single calls
+spVALUE readBatchValue(spDataObject& _response)
+{
+    (*_response).performModifier(mod_valueToCompactEvenHexPrefixed);
+    if (_response->type() == DataType::String)
+        return spVALUE(new VALUE(_response));
+    return spVALUE(new VALUE(_response->asInt()));
+}
+
+spBYTES readBatchCode(spDataObject const& _response)
+{
+    if (_response->asString().empty())
+        return spBYTES(new BYTES(DataObject("0x")));
+    return spBYTES(new BYTES(_response));
+}
+
+// Balance, nonce, code and first storage page of the account are requested by 4 calls
+// that are answered in any order when batched or pipelined
+size_t const c_callsPerAccount = 4;
+struct RemoteAccountParts
+{
+    spVALUE balance;
+    spVALUE nonce;
+    spBYTES code;
+    spStorage storage;
+    spFH32 nextKey;
+    size_t received = 0;
+};
+
+std::vector<RPCBatchCall> makeAccountCalls(VALUE const& _bNumber, VALUE const& _trIndex, std::vector<FH20> const& _accounts)
+{
+    string const bNumber = "\"" + _bNumber.asString() + "\"";
+    string const bNumberDec = "\"" + _bNumber.asDecString() + "\"";
+    string const zeroHash = "\"" + FH32::zero().asString() + "\"";
+    std::vector<RPCBatchCall> calls;
+    calls.reserve(_accounts.size() * c_callsPerAccount);
+    for (auto const& acc : _accounts)
+    {
+        string const address = "\"" + acc.asString() + "\"";
+        calls.push_back({"eth_getBalance", {address, bNumber}});
+        calls.push_back({"eth_getTransactionCount", {address, bNumber}});
+        calls.push_back({"eth_getCode", {address, bNumber}});
+        calls.push_back({"debug_storageRangeAt",
+            {bNumberDec, _trIndex.asDecString(), address, zeroHash, to_string(c_storagePageSize)}});
+    }
+    return calls;
+}
+
+void readAccountCall(RemoteAccountParts& _parts, size_t _callIndex, spDataObject& _response)
+{
+    switch (_callIndex % c_callsPerAccount)
+    {
+    case 0:
+        _parts.balance = spVALUE(new VALUE(_response));
+        break;
+    case 1:
+        _parts.nonce = readBatchValue(_response);
+        break;
+    case 2:
+        _parts.code = readBatchCode(_response);
+        break;
+    default:
+    {
+        DebugStorageRangeAt const firstPage(_response);
+        _parts.storage = spStorage(new Storage(DataObject(DataType::Object)));
+        (*_parts.storage).merge(firstPage.storage());
+        _parts.nextKey = spFH32(firstPage.nextKey().copy());
+    }
+    }
+    _parts.received++;
+}
+
+// Read the rest of storage pages if any
+State::Account finishAccount(SessionInterface& _session, VALUE const& _bNumber, VALUE const& _trIndex, FH20 const& _account,
+    RemoteAccountParts& _parts)
+{
+    if (!_parts.nextKey->isZero())
+        remoteGetStorage(_session, _bNumber, _trIndex, _account, _parts.nextKey.getCContent(), _parts.storage.getContent());
+    return State::Account(_account, _parts.balance, _parts.nonce, _parts.code, _parts.storage);
+}
+
+// Try to request the pack of accounts in one batch, then with pipelined requests
+bool remoteGetAccountsBatch(SessionInterface& _session, VALUE const& _bNumber, VALUE const& _trIndex,
+    std::vector<FH20> const& _accounts, size_t _offset, AccountCallback const& _onAccount)
+{
+    std::vector<RPCBatchCall> const calls = makeAccountCalls(_bNumber, _trIndex, _accounts);
+    std::vector<RemoteAccountParts> parts(_accounts.size());
+
+    std::vector<spDataObject> responses = _session.rpcBatch(calls);
+    if (!responses.empty())
+    {
+        for (size_t i = 0; i < calls.size(); i++)
+            readAccountCall(parts.at(i / c_callsPerAccount), i, responses.at(i));
+        for (size_t i = 0; i < _accounts.size(); i++)
+            _onAccount(_offset + i, finishAccount(_session, _bNumber, _trIndex, _accounts.at(i), parts.at(i)));
+        return true;
+    }
+
+    // Accounts are processed as soon as all of its fields arrive
+    // Accounts with more storage pages are finished when the pipeline is over
+    std::vector<size_t> unfinished;
+    auto onResult = [&](size_t _callIndex, spDataObject& _response) {
+        size_t const accIndex = _callIndex / c_callsPerAccount;
+        RemoteAccountParts& accParts = parts.at(accIndex);
+        readAccountCall(accParts, _callIndex, _response);
+        if (accParts.received < c_callsPerAccount)
+            return;
+        if (accParts.nextKey->isZero())
+            _onAccount(_offset + accIndex, finishAccount(_session, _bNumber, _trIndex, _accounts.at(accIndex), accParts));
+        else
+            unfinished.emplace_back(accIndex);
+    };
+    if (!_session.rpcPipeline(calls, c_pipelineWindow, onResult))
+        return false;
+    for (size_t const accIndex : unfinished)
+        _onAccount(_offset + accIndex, finishAccount(_session, _bNumber, _trIndex, _accounts.at(accIndex), parts.at(accIndex)));
+    return true;
+}
+
+void remoteGetAccounts(SessionInterface& _session, VALUE const& _bNumber, VALUE const& _trIndex,
+    std::vector<FH20> const& _accounts, AccountCallback const& _onAccount)
+{
+    for (size_t i = 0; i < _accounts.size(); i += c_accountBatchSize)
+    {
+        std::vector<FH20> const pack(_accounts.begin() + i, _accounts.begin() + min(i + c_accountBatchSize, _accounts.size()));
+        if (remoteGetAccountsBatch(_session, _bNumber, _trIndex, pack, i, _onAccount))
+            continue;
+        for (size_t k = 0; k < pack.size(); k++)
+            _onAccount(i + k, remoteGetAccount(_session, _bNumber, _trIndex, pack.at(k)));
+    }
+}
+}  // namespace
+
 // Get full remote state from the client
 spState getRemoteState(SessionInterface& _session)
 {
+    if (spState state = _session.lastBlockState(); !state.isEmpty())
+        return state;
+
     VALUE const recentBNumber = _session.eth_blockNumber();
     EthGetBlockBy recentBlock(_session.eth_getBlockByNumber(recentBNumber, Request::LESSOBJECTS));
     VALUE trIndex(recentBlock.transactions().size());
 
-    // Construct accountList by asking packs of 10th of accounts from remote client
+    // Construct accountList by asking packs of accounts from remote client
     std::vector<FH20> accountList;
     FH32 nextKey("0x0000000000000000000000000000000000000000000000000000000000000001");
     while (!nextKey.isZero())
     {
-        DebugAccountRange range(_session.debug_accountRange(recentBNumber, trIndex, nextKey, 10));
+        DebugAccountRange range(_session.debug_accountRange(recentBNumber, trIndex, nextKey, c_accountRangeSize));
         for (auto const& el : range.addresses())
         {
             accountList.emplace_back(el);
@@ -59,16 +212,11 @@ spState getRemoteState(SessionInterface& _session)
         nextKey = range.nextKey();
     }
 
-    // Use recentBNumber and trIndex once to request account information in loop
-    auto getRemoteAccount = [&_session, &recentBNumber, &trIndex](
-                                FH20 const& _account) { return remoteGetAccount(_session, recentBNumber, trIndex, _account); };
-
     size_t byteSize = 0;
     std::map<FH20, spAccountBase> stateAccountMap;
-    for (auto const& acc : accountList)
-    {
-        spAccountBase remAccount(new State::Account(getRemoteAccount(acc)));
-        stateAccountMap.emplace(acc, remAccount);
+    remoteGetAccounts(_session, recentBNumber, trIndex, accountList, [&](size_t, State::Account const& _remote) {
+        spAccountBase remAccount(new State::Account(_remote));
+        stateAccountMap.emplace(_remote.address(), remAccount);
         if (!Options::get().fullstate)
         {
             byteSize += remAccount->storage().getKeys().size() * 64;
@@ -76,58 +224,63 @@ spState getRemoteState(SessionInterface& _session)
             //if (byteSize > 1048510 * 2) // 2MB
             //    throw StateTooBig();
         }
-    }
+    });
     return spState(new State(stateAccountMap));
 }
 
 // Compare expected state with session asking post state data on the fly
 void compareStates(StateBase const& _stateExpect, SessionInterface& _session)
 {
+    if (spState const state = _session.lastBlockState(); !state.isEmpty())
+        return compareStates(_stateExpect, state.getCContent());
+
+    ProfileScope profile(ProfilePhase::CompareState);
     CompareResult result = CompareResult::Success;
 
     VALUE recentBNumber(_session.eth_blockNumber());
     EthGetBlockBy recentBlock(_session.eth_getBlockByNumber(recentBNumber, Request::LESSOBJECTS));
     VALUE trIndex(recentBlock.transactions().size());
 
-    // Use recentBNumber and trIndex once to request account information in loop
-    auto getRemoteAccount = [&_session, &recentBNumber, &trIndex](
-                                FH20 const& _account) { return remoteGetAccount(_session, recentBNumber, trIndex, _account); };
-
-    // Construct accountList by asking packs of 10th of accounts from remote client
+    // Construct accountList by asking packs of accounts from remote client
     std::set<FH20> remoteAccountList;
     FH32 nextKey("0x0000000000000000000000000000000000000000000000000000000000000001");
     while (!nextKey.isZero())
     {
-        DebugAccountRange range(_session.debug_accountRange(recentBNumber, trIndex, nextKey, 10));
+        DebugAccountRange range(_session.debug_accountRange(recentBNumber, trIndex, nextKey, c_accountRangeSize));
         for (auto const& el : range.addresses())
             remoteAccountList.insert(el);
         nextKey = range.nextKey();
     }
 
-    for (auto const& ael : _stateExpect.accounts())
-    {
-        AccountBase const& a = ael.second.getCContent();
+    std::vector<AccountBase const*> compareList;
+    std::vector<FH20> requestList;
+    _stateExpect.forEachAccount([&](FH20 const&, spAccountBase const& _acc) {
+        AccountBase const& a = _acc.getCContent();
         bool remoteHasAccount = remoteAccountList.count(a.address());
         if (a.shouldNotExist() && remoteHasAccount)
         {
             ETH_MARK_ERROR("Compare States: '" + a.address().asString() + "' address not expected to exist!");
             result = CompareResult::AccountShouldNotExist;
-            continue;
+            return;
         }
         else if (!a.shouldNotExist() && !remoteHasAccount)
         {
             ETH_MARK_ERROR("Compare States: Missing expected address: '" + a.address().asString() + "'");
             result = CompareResult::MissingExpectedAccount;
-            continue;
+            return;
         }
         else if (a.shouldNotExist() && !remoteHasAccount)
-            continue;
+            return;
+        compareList.emplace_back(&a);
+        requestList.emplace_back(a.address());
+    });
 
-        // Compare account in postState with expect section account
-        CompareResult accountCompareResult = compareAccounts(a, getRemoteAccount(a.address()));
+    // Compare account in postState with expect section account as remote accounts arrive
+    remoteGetAccounts(_session, recentBNumber, trIndex, requestList, [&](size_t _index, State::Account const& _remote) {
+        CompareResult accountCompareResult = compareAccounts(*compareList.at(_index), _remote);
         if (accountCompareResult != CompareResult::Success)
             result = accountCompareResult;
-    }
+    });
 
     if (result != CompareResult::Success)
         ETH_ERROR_MESSAGE("CompareStates failed with errors: " + CompareResultToString(result));
@@ -257,31 +410,31 @@ CompareResult compareAccounts(AccountBase const& _expectAccount, State::Account
 // Compare expected state again post state
 void compareStates(StateBase const& _stateExpect, State const& _statePost)
 {
+    ProfileScope profile(ProfilePhase::CompareState);
     CompareResult result = CompareResult::Success;
-    for (auto const& ael : _stateExpect.accounts())
-    {
-        AccountBase const& a = ael.second.getCContent();
+    _stateExpect.forEachAccount([&](FH20 const&, spAccountBase const& _acc) {
+        AccountBase const& a = _acc.getCContent();
         bool remoteHasAccount = _statePost.hasAccount(a.address());
         if (a.shouldNotExist() && remoteHasAccount)
         {
             ETH_MARK_ERROR("Compare States: '" + a.address().asString() + "' address not expected to exist!");
             result = CompareResult::AccountShouldNotExist;
-            continue;
+            return;
         }
         else if (!a.shouldNotExist() && !remoteHasAccount)
         {
             ETH_MARK_ERROR("Compare States: Missing expected address: '" + a.address().asString() + "'");
             result = CompareResult::MissingExpectedAccount;
-            continue;
+            return;
         }
         else if (a.shouldNotExist() && !remoteHasAccount)
-            continue;
+            return;
 
         // Compare account in postState with expect section account
         CompareResult accountCompareResult = compareAccounts(a, _statePost.getAccount(a.address()));
         if (accountCompareResult != CompareResult::Success)
             result = accountCompareResult;
-    }
+    });
     auto const& opt = Options::get();
     if (opt.poststate && !opt.poststate.isBlockSelected)
         ETH_DC_MESSAGE(DC::STATE, "Compare States State Dump: " +
@@ -7,6 +7,7 @@
 #include <retesteth/Options.h>
 #include <retesteth/helpers/TestHelper.h>
 #include <retesteth/ExitHandler.h>
+#include <retesteth/session/ToolBackend/ToolChainHelper.h>
 
 using namespace std;
 using namespace test;
@@ -15,12 +16,35 @@ namespace fs = boost::filesystem;
 namespace
 {
 
-spDataObject makeTest(FORK const& _fork, VALUE const& _bn, VALUE const& _td, VALUE const& _pd, VALUE const& _un)
+// With nativeDifficulty config retesteth calculates vectors of known forks itself
+// and asks the client only for a sample of them, checking that both agree
+VALUE calculateDifficulty(FORK const& _fork, VALUE const& _bn, VALUE const& _td, VALUE const& _pd, VALUE const& _un, size_t _index)
 {
-    spDataObject test;
     SessionInterface& session = RPCSession::instance(TestOutputHelper::getThreadID());
+    auto const& cfg = Options::getCurrentConfig().cfgFile();
+    toolimpl::ChainOperationParams params;
+    if (!cfg.nativeDifficulty() || !toolimpl::ChainOperationParams::forkParams(_fork, params))
+        return session.test_calculateDifficulty(_fork, _bn, 0, _pd, _td, _un);
+
+    if (_bn == 0)
+        ETH_ERROR_MESSAGE("DifficultyTest calculating difficulty for blocknumber 0!");
+    VALUE const res = toolimpl::calculateEthashDifficulty(
+        params, _bn.asBigInt(), _td.asBigInt(), _bn.asBigInt() - 1, 0, _pd.asBigInt(), _un > 0);
+    if (cfg.nativeDifficultyToolCheck() != 0 && _index % cfg.nativeDifficultyToolCheck() == 0)
+    {
+        VALUE const toolRes = session.test_calculateDifficulty(_fork, _bn, 0, _pd, _td, _un);
+        ETH_ERROR_REQUIRE_MESSAGE(toolRes == res, "DifficultyTest " + _fork.asString() + " native difficulty `" +
+                                                      res.asDecString() + "` differs from client `" + toolRes.asDecString() +
+                                                      "` for block " + _bn.asDecString() + ", timestamp " + _td.asDecString() +
+                                                      ", parent difficulty " + _pd.asDecString());
+    }
+    return res;
+}
 
-    VALUE const res = session.test_calculateDifficulty(_fork, _bn, 0, _pd, _td, _un);
+spDataObject makeTest(FORK const& _fork, VALUE const& _bn, VALUE const& _td, VALUE const& _pd, VALUE const& _un, size_t _index)
+{
+    spDataObject test;
+    VALUE const res = calculateDifficulty(_fork, _bn, _td, _pd, _un, _index);
     (*test)["parentTimestamp"] = "0x00";
     (*test)["parentUncles"] = _un.asString();
     (*test)["parentDifficulty"] = _pd.asString();
@@ -65,8 +89,9 @@ spDataObject FillTest(DifficultyTestInFiller const& _test)
                     {
                         if (ExitHandler::receivedExitSignal())
                             break;
-                        string const testname = _test.testName() + "-" + test::fto_string(i++);
-                        (*filledTestNetwork).atKeyPointer(testname) = makeTest(fork, bn, td, pd, un);
+                        string const testname = _test.testName() + "-" + test::fto_string(i);
+                        (*filledTestNetwork).atKeyPointer(testname) = makeTest(fork, bn, td, pd, un, i);
+                        i++;
                     }
                 }
             }
@@ -4,18 +4,75 @@
 #include <libdevcore/SHA3.h>
 #include <retesteth/ExitHandler.h>
 #include <retesteth/helpers/TestOutputHelper.h>
+#include <retesteth/session/ThreadManager.h>
 #include <retesteth/testStructures/types/Ethereum/Transactions/TransactionLegacy.h>
 #include <retesteth/testStructures/types/TransactionTests/TransactionTest.h>
 #include <retesteth/testStructures/types/TransactionTests/TransactionTestFiller.h>
 #include <retesteth/testSuites/Common.h>
 #include <retesteth/Options.h>
+#include <algorithm>
+#include <mutex>
 
 using namespace std;
 using namespace test;
+using namespace test::debug;
 using namespace test::session;
 namespace fs = boost::filesystem;
 namespace
 {
+// Transactions sent to the tool with one call when prefetching a folder
+size_t const c_prefetchChunkSize = 256;
+// Smaller batches are not worth an extra call, such transactions are validated when the test runs
+size_t const c_prefetchMinBatch = 8;
+
+// Results of the transactions validated in batches before the tests of a folder are started
+// Kept as json, the data objects are not shared between the threads
+std::mutex g_prefetchedResultsMutex;
+std::map<std::pair<string, string>, string> g_prefetchedResults;  // (fork, rlp) => test_rawTransaction response
+
+TestRawTransaction validateTransaction(SessionInterface& _session, BYTES const& _rlp, FORK const& _fork)
+{
+    string response;
+    {
+        std::lock_guard<std::mutex> lock(g_prefetchedResultsMutex);
+        auto const it = g_prefetchedResults.find({_fork.asString(), _rlp.asString()});
+        if (it != g_prefetchedResults.end())
+            response = it->second;
+    }
+    if (response.empty())
+        return _session.test_rawTransaction(_rlp, _fork);
+    return TestRawTransaction(dataobject::ConvertJsoncppStringToData(response).getCContent());
+}
+
+// Returns the number of transactions validated
+size_t prefetchTransactions(SessionInterface& _session, vector<BYTES> const& _rlps, FORK const& _fork)
+{
+    if (_rlps.size() < c_prefetchMinBatch || ExitHandler::receivedExitSignal())
+        return 0;
+
+    auto const results = _session.test_rawTransactions(_rlps, _fork);
+    if (results.size() == _rlps.size())
+    {
+        std::lock_guard<std::mutex> lock(g_prefetchedResultsMutex);
+        for (size_t i = 0; i < _rlps.size(); i++)
+            g_prefetchedResults[{_fork.asString(), _rlps.at(i).asString()}] = results.at(i).asDataObject()->asJson();
+        return results.size();
+    }
+
+    // One transaction the tool can not decode fails the whole batch
+    size_t const half = _rlps.size() / 2;
+    vector<BYTES> const first(_rlps.begin(), _rlps.begin() + half);
+    vector<BYTES> const second(_rlps.begin() + half, _rlps.end());
+    return prefetchTransactions(_session, first, _fork) + prefetchTransactions(_session, second, _fork);
+}
+
+bool isHexString(string const& _str)
+{
+    if (_str.size() < 4 || _str.size() % 2 != 0 || _str.compare(0, 2, "0x") != 0)
+        return false;
+    return std::all_of(_str.begin() + 2, _str.end(), [](unsigned char _c) { return isxdigit(_c); });
+}
+
 spDataObject FillTest(TransactionTestInFiller const& _test)
 {
     spDataObject filledTest;
@@ -46,7 +103,7 @@ spDataObject FillTest(TransactionTestInFiller const& _test)
         TestInfo errorInfo("test_rawTransaction: " + fork.asString(), _test.testName());
         TestOutputHelper::get().setCurrentTestInfo(errorInfo);
 
-        TestRawTransaction res = session.test_rawTransaction(_test.transaction()->getRawBytes(), fork);
+        TestRawTransaction res = validateTransaction(session, _test.transaction()->getRawBytes(), fork);
         compareTransactionException(_test.transaction(), res, _test.getExpectException(fork));
 
         spDataObject result;
@@ -78,7 +135,7 @@ void RunTest(TransactionTestInFilled const& _test)
         if (networkSkip(fork, _test.testName()))
             continue;
 
-        TestRawTransaction res = session.test_rawTransaction(_test.rlp(), fork);
+        TestRawTransaction res = validateTransaction(session, _test.rlp(), fork);
         if (_test.transaction().isEmpty())
         {
             // Retesteth was unable to read the transaction rlp from the test into a valid transaction
@@ -162,6 +219,98 @@ spDataObject TransactionTestSuite::doTests(spDataObject& _input, TestSuiteOption
     return spDataObject();
 }
 
+void TransactionTestSuite::prepareTestFolder(string const& _testFolder, vector<fs::path> const& _fillers) const
+{
+    {
+        std::lock_guard<std::mutex> lock(g_prefetchedResultsMutex);
+        g_prefetchedResults.clear();
+    }
+    auto const& opt = Options::get();
+    if (opt.checkhash || opt.getvectors)
+        return;
+
+    // Only the transition tool validates transactions in batches, do not open a session for other clients
+    auto const& cfg = Options::getCurrentConfig();
+    if (cfg.cfgFile().socketType() != ClientConfgSocketType::TransitionTool)
+        return;
+
+    // Take txbytes from the filled tests. When filling, the filled tests of changed fillers
+    // still have most of the transactions. Results are looked up by rlp so nothing outdated is used
+    auto const allowedFork = [&opt, &cfg](FORK const& _fork) {
+        if (opt.singleTestNet.initialized() && opt.singleTestNet != _fork.asString())
+            return false;
+        return cfg.checkForkAllowed(_fork) && !cfg.checkForkSkipOnFiller(_fork);
+    };
+
+    std::map<FORK, std::set<string>> forkTxs;
+    fs::path const filledFolder = getFullPathFilled(_testFolder).path();
+    for (auto const& filler : _fillers)
+    {
+        string const fillerName = filler.stem().string();
+        size_t const pos = fillerName.rfind(c_fillerPostf);
+        if (pos == string::npos)
+            continue;
+        fs::path const filledTest = filledFolder / (fillerName.substr(0, pos) + ".json");
+        if (!fs::exists(filledTest))
+            continue;
+        try
+        {
+            spDataObject const data = test::readJsonData(filledTest);
+            for (auto const& test : data->getSubObjects())
+            {
+                if (!test->count("txbytes") || !test->count("result") || !isHexString(test->atKey("txbytes").asString()))
+                    continue;
+                string const rlp = BYTES(test->atKey("txbytes").asString()).asString();
+                std::set<FORK> forks;
+                for (auto const& result : test->atKey("result").getSubObjects())
+                    forks.emplace(FORK(result->getKey()));
+                if (opt.filltests)
+                    for (auto const& fork : cfg.cfgFile().forks())
+                        forks.emplace(fork);
+                for (auto const& fork : forks)
+                    if (allowedFork(fork))
+                        forkTxs[fork].emplace(rlp);
+            }
+        }
+        catch (std::exception const&)
+        {
+            // Broken test files are reported when the test runs
+        }
+    }
+    if (forkTxs.empty())
+        return;
+
+    auto prefetch = [&forkTxs]() {
+        TestOutputHelper::get().setCurrentTestInfo(TestInfo("TransactionTestSuite::prepareTestFolder"));
+        RPCSession::sessionStart(TestOutputHelper::getThreadID());
+        SessionInterface& session = RPCSession::instance(TestOutputHelper::getThreadID());
+        for (auto const& [fork, rlps] : forkTxs)
+        {
+            vector<BYTES> txs;
+            for (auto const& rlp : rlps)
+                txs.emplace_back(BYTES(rlp));
+
+            size_t validated = 0;
+            for (size_t i = 0; i < txs.size(); i += c_prefetchChunkSize)
+            {
+                vector<BYTES> const chunk(txs.begin() + i, txs.begin() + std::min(i + c_prefetchChunkSize, txs.size()));
+                size_t const res = prefetchTransactions(session, chunk, fork);
+                // The client can not validate in batches, do not try the rest
+                if (res == 0 && validated == 0)
+                    break;
+                validated += res;
+            }
+            ETH_DC_MESSAGE(DC::STATS2, "Prefetched " + test::fto_string(validated) + " of " +
+                                           test::fto_string(txs.size()) + " transactions for " + fork.asString());
+        }
+        RPCSession::sessionEnd(TestOutputHelper::getThreadID(), RPCSession::SessionStatus::HasFinished);
+    };
+
+    // A worker of the test run validates the batches and keeps its session for the tests,
+    // the main thread opening a session would connect to one client more than -j allows
+    ThreadManager::addTask(prefetch).get();
+}
+
 /// TEST SUITE ///
 
 TestSuite::TestPath TransactionTestSuite::suiteFolder() const
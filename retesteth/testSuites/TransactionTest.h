@@ -32,6 +32,10 @@ public:
     dataobject::spDataObject doTests(dataobject::spDataObject& _input, TestSuiteOptions& _opt) const override;
     TestSuite::TestPath suiteFolder() const override;
     TestSuite::FillerPath suiteFillerFolder() const override;
+
+protected:
+    // Validate the transactions of all filled tests in the folder with batched tool calls
+    void prepareTestFolder(std::string const& _testFolder, std::vector<boost::filesystem::path> const& _fillers) const override;
 };
 
 }  // namespace test
@@ -101,7 +101,7 @@ void BlockchainTestFillerRunner::compareFinalState(spDataObject& _filledTest, St
 {
     try
     {
-        spState remoteState = getRemoteState(m_session);
+        spState const remoteState = getRemoteState(m_session);
         compareStates(_expectState, remoteState);
         (*_filledTest).atKeyPointer("postState") = remoteState->asDataObject();
     }
@@ -311,8 +311,9 @@ string definePre(StateTestInFiller const& _test)
     string res = "@pytest.fixture\n";
     res += "def pre():  # noqa: D103\n";
     res += "    return {\n";
-    for (auto const& [addr, acc] : _test.Pre().accounts())
-        defineAccount(res, acc, {.insertTabsNumber = 1, .convertPy = true});
+    _test.Pre().forEachAccount([&res](FH20 const&, spAccountBase const& _acc) {
+        defineAccount(res, _acc, {.insertTabsNumber = 1, .convertPy = true});
+    });
     res += "    }\n\n";
     return res;
 }
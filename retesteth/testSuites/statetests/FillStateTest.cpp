@@ -4,6 +4,7 @@
 #include <retesteth/helpers/TestOutputHelper.h>
 #include "Options.h"
 #include "session/Session.h"
+#include "session/ThreadManager.h"
 #include "testSuites/Common.h"
 #include "testStructures/PrepareChainParams.h"
 
@@ -28,21 +29,35 @@ spDataObject FillTest(StateTestInFiller const& _test, TestSuite::TestSuiteOption
     else
         runner = std::make_unique<StateTestFillerRunner>(_test, _opt);
 
+    // (fork, transaction) runs spread over worker sessions, registered in the filled test order
+    struct TransactionJob
+    {
+        FORK fork;
+        StateTestFillerExpectSection const& expect;
+        size_t txIndex;
+        TransactionInGeneralSection tr;
+        spDataObject result;
+    };
+    std::vector<TransactionJob> jobs;
+    bool const shareTransactions = canShareTransactions(_test.hasBigInt(), !_test.unitTestExceptions().empty());
+
     if (!runner->checkBigintSkip())
     for (auto const& fork : allforks)
     {
         if (runner->checkNetworkSkip(fork))
             continue;
 
-        runner->prepareChainParams(fork);
+        if (!shareTransactions)
+            runner->prepareChainParams(fork);
         for (auto const& expect : _test.Expects())
         {
             if (!expect.hasFork(fork))
                 continue;
 
             bool expectFoundTransaction = false;
-            for (auto& tr : runner->txs())
+            for (size_t i = 0; i < runner->txs().size(); i++)
             {
+                auto& tr = runner->txs().at(i);
                 runner->setErrorInfo(tr, fork);
                 bool expectChekIndexes = expect.checkIndexes(tr.dataInd(), tr.gasInd(), tr.valueInd());
                 if (!optionsAllowTransaction(tr))
@@ -61,7 +76,10 @@ spDataObject FillTest(StateTestInFiller const& _test, TestSuite::TestSuiteOption
                     ETH_ERROR_MESSAGE("Test filler pre state has empty account which is not allowed after Paris" + TestOutputHelper::get().testInfo().errorDebug());
 
                 expectFoundTransaction = true;
-                runner->performTransactionOnExpect(tr, expect, fork);
+                if (shareTransactions)
+                    jobs.push_back({fork, expect, i, tr.detachedCopy(), spDataObject(0)});
+                else
+                    runner->performTransactionOnExpect(tr, expect, fork);
             }
 
             if (expectFoundTransaction == false)
@@ -71,9 +89,42 @@ spDataObject FillTest(StateTestInFiller const& _test, TestSuite::TestSuiteOption
             }
         }
 
-        runner->registerForkResult();
+        if (!shareTransactions)
+            runner->registerForkResult();
     }
 
+    if (shareTransactions && !jobs.empty())
+    {
+        SharedTestSessions sessions([&runner](SessionInterface& _session, FORK const& _fork) {
+            runner->setChainParams(_session, _fork);
+        });
+        ThreadManager::runShared(
+            jobs.size(),
+            [&runner, &jobs, &sessions](size_t _index) {
+                TransactionJob& job = jobs.at(_index);
+                sessions.attach();
+                runner->setErrorInfo(job.tr, job.fork);
+                SessionInterface& session = sessions.session(job.fork);
+                job.result = runner->executeTransaction(session, job.tr, job.expect, job.fork);
+            },
+            [&sessions]() { sessions.release(); });
+
+        runner->beginForkResult(jobs.at(0).fork);
+        for (size_t i = 0; i < jobs.size(); i++)
+        {
+            TransactionJob const& job = jobs.at(i);
+            if (i > 0 && job.fork != jobs.at(i - 1).fork)
+            {
+                runner->registerForkResult();
+                runner->beginForkResult(job.fork);
+            }
+            auto& tr = runner->txs().at(job.txIndex);
+            tr.markExecuted();
+            tr.assignTransactionHash(job.tr.reportedHash());
+            runner->registerTransactionResult(job.tr, job.fork, job.result);
+        }
+        runner->registerForkResult();
+    }
 
     checkUnexecutedTransactions(runner->txs(), Report::ERROR);
 
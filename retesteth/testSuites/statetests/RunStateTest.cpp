@@ -2,9 +2,11 @@
 #include "StateTestsHelper.h"
 #include "StateTestRunner.h"
 #include <retesteth/ExitHandler.h>
+#include <retesteth/session/ThreadManager.h>
 
 using namespace std;
 using namespace test;
+using namespace test::session;
 namespace test::statetests
 {
 
@@ -13,6 +15,17 @@ void RunTest(StateTestInFilled const& _test)
     CHECKEXIT
     StateTestRunner runner(_test);
 
+    // (fork, transaction) runs spread over worker sessions
+    struct TransactionJob
+    {
+        FORK fork;
+        StateTestPostResult const& result;
+        size_t txIndex;
+        TransactionInGeneralSection tr;
+    };
+    std::vector<TransactionJob> jobs;
+    bool const shareTransactions = canShareTransactions(_test.hasBigInt(), !_test.unitTestExceptions().empty());
+
     if (!runner.checkBigintSkip())
     for (auto const& [network, postResults] : _test.Post())
     {
@@ -20,16 +33,18 @@ void RunTest(StateTestInFilled const& _test)
         if (runner.checkNetworkSkip(network))
             continue;
 
-        runner.prepareChainParams(network);
+        if (!shareTransactions)
+            runner.prepareChainParams(network);
         for (StateTestPostResult const& result : postResults)
         {
             bool resultHaveCorrespondingTransaction = false;
 
             // look for a transaction with this indexes and execute it on a client
-            for (TransactionInGeneralSection& tr : runner.txs())
+            for (size_t i = 0; i < runner.txs().size(); i++)
             {
                 CHECKEXIT
 
+                TransactionInGeneralSection& tr = runner.txs().at(i);
                 runner.setTransactionInfo(tr, network);
 
                 bool const checkIndexes = result.checkIndexes(tr.dataInd(), tr.gasInd(), tr.valueInd());
@@ -43,7 +58,12 @@ void RunTest(StateTestInFilled const& _test)
                 }
 
                 if (checkIndexes)
-                    runner.performTransactionOnResult(tr, result, network);
+                {
+                    if (shareTransactions)
+                        jobs.push_back({network, result, i, tr.detachedCopy()});
+                    else
+                        runner.performTransactionOnResult(tr, result, network);
+                }
 
             }  // ForTransactions
 
@@ -52,6 +72,32 @@ void RunTest(StateTestInFilled const& _test)
         }
     }
 
+    if (!jobs.empty())
+    {
+        SharedTestSessions sessions([&runner](SessionInterface& _session, FORK const& _network) {
+            runner.setChainParams(_session, _network);
+        });
+        ThreadManager::runShared(
+            jobs.size(),
+            [&runner, &jobs, &sessions](size_t _index) {
+                CHECKEXIT
+                TransactionJob& job = jobs.at(_index);
+                sessions.attach();
+                runner.setTransactionInfo(job.tr, job.fork);
+                SessionInterface& session = sessions.session(job.fork);
+                runner.performTransactionOnResult(session, job.tr, job.result, job.fork);
+            },
+            [&sessions]() { sessions.release(); });
+
+        for (auto const& job : jobs)
+        {
+            auto& tr = runner.txs().at(job.txIndex);
+            if (job.tr.getExecuted())
+                tr.markExecuted();
+            tr.assignTransactionHash(job.tr.reportedHash());
+        }
+    }
+
     checkUnexecutedTransactions(runner.txs(), Report::WARNING);
 
 }
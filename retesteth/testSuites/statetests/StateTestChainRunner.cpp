@@ -187,7 +187,7 @@ void StateTestChainRunner::comparePostState(StateTestFillerExpectSection const&
     auto mexpect = correctMiningReward(_expect, _network);
     try
     {
-        spState postState = getRemoteState(m_session);
+        spState const postState = getRemoteState(m_session);
         compareStates(mexpect, postState);
         (*m_aBlockchainTest).atKeyPointer("postState") = postState->asDataObject();
         (*m_aBlockchainTest).removeKey("postStateHash");
@@ -85,13 +85,22 @@ bool StateTestFillerRunner::checkNetworkSkip(FORK const& _network)
 
 void StateTestFillerRunner::prepareChainParams(FORK const& _network)
 {
-    (*m_forkResults).setKey(_network.asString());
+    beginForkResult(_network);
 
     TestInfo errorInfo("test_setChainParams: " + _network.asString(), m_test.testName());
     TestOutputHelper::get().setCurrentTestInfo(errorInfo);
+    setChainParams(m_session, _network);
+}
 
+void StateTestFillerRunner::setChainParams(SessionInterface& _session, FORK const& _network) const
+{
     auto const p = test::teststruct::prepareChainParams(_network, SealEngine::NoReward, m_test.Pre(), m_test.Env(), ParamsContext::StateTests);
-    m_session.test_setChainParamsNoGenesis(p);
+    _session.test_setChainParamsNoGenesis(p);
+}
+
+void StateTestFillerRunner::beginForkResult(FORK const& _network)
+{
+    (*m_forkResults).setKey(_network.asString());
 }
 
 void StateTestFillerRunner::setErrorInfo(TransactionInGeneralSection const& _tr, FORK const& _network)
@@ -104,18 +113,25 @@ void StateTestFillerRunner::setErrorInfo(TransactionInGeneralSection const& _tr,
 }
 
 void StateTestFillerRunner::performTransactionOnExpect(TransactionInGeneralSection& _tr, StateTestFillerExpectSection const& _expect, FORK const& _network)
+{
+    spDataObject const transactionResults = executeTransaction(m_session, _tr, _expect, _network);
+    registerTransactionResult(_tr, _network, transactionResults);
+}
+
+spDataObject StateTestFillerRunner::executeTransaction(SessionInterface& _session, TransactionInGeneralSection& _tr,
+    StateTestFillerExpectSection const& _expect, FORK const& _network) const
 {
     auto const& ethTr = _tr.transaction();
-    m_session.test_modifyTimestamp(m_test.Env().firstBlockTimestamp());
+    _session.test_modifyTimestamp(m_test.Env().firstBlockTimestamp());
     modifyTransactionChainIDByNetwork(ethTr, _network);
-    FH32 trHash(m_session.eth_sendRawTransaction(ethTr->getRawBytes(), ethTr->getSecret()));
+    FH32 trHash(_session.eth_sendRawTransaction(ethTr->getRawBytes(), ethTr->getSecret()));
 
-    MineBlocksResult const mRes = m_session.test_mineBlocks(1);
+    MineBlocksResult const mRes = _session.test_mineBlocks(1);
     string const& testException = _expect.getExpectException(_network);
     compareTransactionException(ethTr, mRes, testException);
 
-    VALUE latestBlockN(m_session.eth_blockNumber());
-    EthGetBlockBy remoteBlock(m_session.eth_getBlockByNumber(latestBlockN, Request::LESSOBJECTS));
+    VALUE latestBlockN(_session.eth_blockNumber());
+    EthGetBlockBy remoteBlock(_session.eth_getBlockByNumber(latestBlockN, Request::LESSOBJECTS));
     if (!remoteBlock.hasTransaction(trHash) && testException.empty())
         ETH_ERROR_MESSAGE("StateTest::FillTest: " + c_trHashNotFound);
 
@@ -123,14 +139,14 @@ void StateTestFillerRunner::performTransactionOnExpect(TransactionInGeneralSecti
     _tr.assignTransactionHash(trHash);
 
     performPoststate(remoteBlock);
-    performStatediff();
-    performVmtrace(remoteBlock, _tr, _network);
-    string const vmTraceStr = performVmtraceAnalys(trHash, _expect, _network);
+    performStatediff(_session);
+    performVmtrace(_session, remoteBlock, _tr, _network);
+    string const vmTraceStr = performVmtraceAnalys(_session, trHash, _expect, _network);
 
     spDataObject transactionResults;
     try
     {
-        auto const remState = getRemoteState(m_session);
+        auto const remState = getRemoteState(_session);
         compareStates(_expect.result(), remState);
 
         auto const& opt = Options::get();
@@ -140,7 +156,7 @@ void StateTestFillerRunner::performTransactionOnExpect(TransactionInGeneralSecti
     }
     catch (StateTooBig const&)
     {
-        compareStates(_expect.result(), m_session);
+        compareStates(_expect.result(), _session);
     }
 
     spDataObject indexes;
@@ -159,19 +175,25 @@ void StateTestFillerRunner::performTransactionOnExpect(TransactionInGeneralSecti
     // Fill up the loghash (optional)
     if (Options::getDynamicOptions().getCurrentConfig().cfgFile().checkLogsHash())
     {
-        FH32 logHash(m_session.test_getLogHash(trHash));
+        FH32 logHash(_session.test_getLogHash(trHash));
         if (!logHash.isZero())
             (*transactionResults)["logs"] = logHash.asString();
     }
 
-    m_session.test_rewindToBlock(VALUE(0));
+    _session.test_rewindToBlock(VALUE(0));
     ETH_DC_MESSAGE(DC::TESTLOG, "Executed: d: " + to_string(_tr.dataInd()) + ", g: " + to_string(_tr.gasInd()) +
                                     ", v: " + to_string(_tr.valueInd()) + ", fork: " + _network.asString());
-    (*m_forkResults).addArrayObject(transactionResults);
+    return transactionResults;
+}
+
+void StateTestFillerRunner::registerTransactionResult(
+    TransactionInGeneralSection const&, FORK const&, spDataObject const& _transactionResults)
+{
+    (*m_forkResults).addArrayObject(_transactionResults);
 }
 
 
-void StateTestFillerRunner::performPoststate(EthGetBlockBy const& _blockInfo)
+void StateTestFillerRunner::performPoststate(EthGetBlockBy const& _blockInfo) const
 {
     if (Options::get().poststate)
         ETH_DC_MESSAGE(DC::STATE, "PostState " + TestOutputHelper::get().testInfo().errorDebug() + " : \n" +
@@ -179,35 +201,37 @@ void StateTestFillerRunner::performPoststate(EthGetBlockBy const& _blockInfo)
 }
 
 
-void StateTestFillerRunner::performStatediff()
+void StateTestFillerRunner::performStatediff(SessionInterface& _session) const
 {
     if (Options::get().statediff)
     {
-        auto const stateDiffJson = stateDiff(m_test.Pre(), getRemoteState(m_session))->asJson();
+        auto const stateDiffJson = stateDiff(m_test.Pre(), getRemoteState(_session))->asJson();
         ETH_DC_MESSAGE(DC::STATE,
             "\nRunning test State Diff:" + TestOutputHelper::get().testInfo().errorDebug() + cDefault + " \n" + stateDiffJson);
     }
 }
 
-void StateTestFillerRunner::performVmtrace(EthGetBlockBy const& _blockInfo, TransactionInGeneralSection const& _tr, FORK const& _network)
+void StateTestFillerRunner::performVmtrace(
+    SessionInterface& _session, EthGetBlockBy const& _blockInfo, TransactionInGeneralSection const& _tr, FORK const& _network) const
 {
     if (Options::get().vmtrace && !Options::get().fillvmtrace)
     {
         string const testNameOut = m_test.testName() + "_d" + _tr.dataIndS() + "g" + _tr.gasIndS() + "v" +
                                    _tr.valueIndS() + "_" + _network.asString() + "_" + _tr.reportedHash().asString() + ".txt";
-        VMtraceinfo info(m_session, _tr.reportedHash(), _blockInfo.header()->stateRoot(), testNameOut);
+        VMtraceinfo info(_session, _tr.reportedHash(), _blockInfo.header()->stateRoot(), testNameOut);
         printVmTrace(info);
     }
 }
 
-string StateTestFillerRunner::performVmtraceAnalys(FH32 const& _trHash, StateTestFillerExpectSection const& _expResult, FORK const& _network)
+string StateTestFillerRunner::performVmtraceAnalys(
+    SessionInterface& _session, FH32 const& _trHash, StateTestFillerExpectSection const& _expResult, FORK const& _network) const
 {
     string vmtrace;
     if (Options::get().fillvmtrace)
     {
         if (!_expResult.getExpectException(_network).empty())
             return vmtrace;
-        DebugVMTrace ret(m_session.debug_traceTransaction(_trHash));
+        DebugVMTrace ret(_session.debug_traceTransaction(_trHash));
         for (auto const& log : ret.getLog())
             vmtrace += dev::toCompactHex(log.op);
     }
@@ -19,16 +19,25 @@ public:
     virtual spDataObject getFilledTest() const;
     void registerForkResult();
     bool checkBigintSkip();
+
+    // Execute the transaction on any worker session, then register the results in the filled test order
+    void setChainParams(test::session::SessionInterface&, FORK const&) const;
+    spDataObject executeTransaction(test::session::SessionInterface&, TransactionInGeneralSection&,
+        StateTestFillerExpectSection const&, FORK const&) const;
+    void beginForkResult(FORK const&);
+    virtual void registerTransactionResult(TransactionInGeneralSection const&, FORK const&, spDataObject const&);
 protected:
     StateTestFillerRunner(StateTestInFiller const& _test, test::session::SessionInterface& _session, TestSuite::TestSuiteOptions const& _opt)
       : m_testSuiteOpt(_opt), m_test(_test), m_session(_session) {}
 
 private:
     void fillInfoWithLabels();
-    void performPoststate(EthGetBlockBy const& _blockInfo);
-    void performStatediff();
-    void performVmtrace(EthGetBlockBy const& _blockInfo, TransactionInGeneralSection const& _tr, FORK const& _network);
-    std::string performVmtraceAnalys(FH32 const& _trHash, StateTestFillerExpectSection const& _expResult, FORK const& _network);
+    void performPoststate(EthGetBlockBy const& _blockInfo) const;
+    void performStatediff(test::session::SessionInterface&) const;
+    void performVmtrace(test::session::SessionInterface&, EthGetBlockBy const& _blockInfo,
+        TransactionInGeneralSection const& _tr, FORK const& _network) const;
+    std::string performVmtraceAnalys(test::session::SessionInterface&, FH32 const& _trHash,
+        StateTestFillerExpectSection const& _expResult, FORK const& _network) const;
 protected:
     TestSuite::TestSuiteOptions const& m_testSuiteOpt;
     spDataObject m_filledTest;
@@ -23,9 +23,10 @@ StateTestFillerRunnerEEST::StateTestFillerRunnerEEST(StateTestInFiller const& _t
     m_finalFilled_test = sDataObject(DataType::Object);
 }
 
-void StateTestFillerRunnerEEST::performTransactionOnExpect(TransactionInGeneralSection& _tx, StateTestFillerExpectSection const& _expect, FORK const& _fork)
+void StateTestFillerRunnerEEST::registerTransactionResult(
+    TransactionInGeneralSection const& _tx, FORK const& _fork, spDataObject const& _transactionResults)
 {
-    StateTestFillerRunner::performTransactionOnExpect(_tx, _expect, _fork);
+    StateTestFillerRunner::registerTransactionResult(_tx, _fork, _transactionResults);
     constructTestVector(_fork, _tx);
 }
 
@@ -34,7 +35,7 @@ spDataObject StateTestFillerRunnerEEST::getFilledTest() const
     return m_finalFilled_test;
 }
 
-void StateTestFillerRunnerEEST::constructTestVector(FORK const& _network, TransactionInGeneralSection& _tx)
+void StateTestFillerRunnerEEST::constructTestVector(FORK const& _network, TransactionInGeneralSection const& _tx)
 {
     spDataObject m_eestTestVector = sDataObject(DataType::Object);
 
@@ -11,11 +11,11 @@ class StateTestFillerRunnerEEST : public StateTestFillerRunner
 {
 public:
     StateTestFillerRunnerEEST(StateTestInFiller const& _test, TestSuite::TestSuiteOptions const& _opt);
-    void performTransactionOnExpect(TransactionInGeneralSection&, StateTestFillerExpectSection const&, FORK const&) override;
+    void registerTransactionResult(TransactionInGeneralSection const&, FORK const&, spDataObject const&) override;
     spDataObject getFilledTest() const override;
 
 protected:
-    void constructTestVector(FORK const& _network, TransactionInGeneralSection&);
+    void constructTestVector(FORK const& _network, TransactionInGeneralSection const&);
 
 private:
     spDataObject m_finalFilled_test;
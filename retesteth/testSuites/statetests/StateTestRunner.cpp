@@ -76,8 +76,13 @@ void StateTestRunner::prepareChainParams(FORK const& _network)
     TestInfo errorInfo("test_setChainParams: " + _network.asString(), m_test.testName());
     TestOutputHelper::get().setCurrentTestInfo(errorInfo);
 
+    setChainParams(m_session, _network);
+}
+
+void StateTestRunner::setChainParams(SessionInterface& _session, FORK const& _network) const
+{
     auto p = test::teststruct::prepareChainParams(_network, SealEngine::NoReward, m_test.Pre(), m_test.Env(), ParamsContext::StateTests);
-    m_session.test_setChainParamsNoGenesis(p);
+    _session.test_setChainParamsNoGenesis(p);
 }
 
 void StateTestRunner::setTransactionInfo(TransactionInGeneralSection& _tr, FORK const& _network)
@@ -89,19 +94,25 @@ void StateTestRunner::setTransactionInfo(TransactionInGeneralSection& _tr, FORK
 
 void StateTestRunner::performTransactionOnResult(TransactionInGeneralSection& _tr,
     StateTestPostResult const& _result, FORK const& _network)
+{
+    performTransactionOnResult(m_session, _tr, _result, _network);
+}
+
+void StateTestRunner::performTransactionOnResult(SessionInterface& _session, TransactionInGeneralSection& _tr,
+    StateTestPostResult const& _result, FORK const& _network)
 {
     auto const& tr = _tr.transaction();
-    m_session.test_modifyTimestamp(m_test.Env().firstBlockTimestamp());
+    _session.test_modifyTimestamp(m_test.Env().firstBlockTimestamp());
     modifyTransactionChainIDByNetwork(tr, _network);
-    FH32 trHash(m_session.eth_sendRawTransaction(tr->getRawBytes(), tr->getSecret()));
+    FH32 trHash(_session.eth_sendRawTransaction(tr->getRawBytes(), tr->getSecret()));
     _tr.assignTransactionHash(trHash);
 
-    MineBlocksResult const mRes = m_session.test_mineBlocks(1);
+    MineBlocksResult const mRes = _session.test_mineBlocks(1);
     string const& testException = _result.expectException();
     compareTransactionException(tr, mRes, testException);
 
-    VALUE latestBlockN(m_session.eth_blockNumber());
-    EthGetBlockBy blockInfo(m_session.eth_getBlockByNumber(latestBlockN, Request::LESSOBJECTS));
+    VALUE latestBlockN(_session.eth_blockNumber());
+    EthGetBlockBy blockInfo(_session.eth_getBlockByNumber(latestBlockN, Request::LESSOBJECTS));
     if (!blockInfo.hasTransaction(trHash) && testException.empty())
         ETH_ERROR_MESSAGE("StateTest::RunTest: " + c_trHashNotFound);
     _tr.markExecuted();
@@ -110,38 +121,40 @@ void StateTestRunner::performTransactionOnResult(TransactionInGeneralSection& _t
     FH32 const& expectedPostHash = _result.hash();
     FH32 const& remoteStateHash = blockInfo.header()->stateRoot();
 
-    performVMTrace(_tr, remoteStateHash, _network);
-    performPostState(_tr, _network, blockInfo);
-    performStateDiff(_tr, _network);
+    performVMTrace(_session, _tr, remoteStateHash, _network);
+    performPostState(_session, _tr, _network, blockInfo);
+    performStateDiff(_session, _tr, _network);
 
     if (remoteStateHash != expectedPostHash)
     {
-        ETH_DC_MESSAGE(DC::TESTLOG, "\nState Dump: \n" + getRemoteState(m_session)->asDataObject()->asJson());
+        ETH_DC_MESSAGE(DC::TESTLOG, "\nState Dump: \n" + getRemoteState(_session)->asDataObject()->asJson());
         ETH_ERROR_MESSAGE("Post hash mismatch remote: " + remoteStateHash.asString() + ", expected: " + expectedPostHash.asString());
     }
-    performValidations(_tr, _result);
+    performValidations(_session, _tr, _result);
 
-    m_session.test_rewindToBlock(0);
+    _session.test_rewindToBlock(0);
     ETH_DC_MESSAGE(DC::TESTLOG, "Executed: d: " + to_string(_tr.dataInd()) + ", g: " + to_string(_tr.gasInd()) +
                                     ", v: " + to_string(_tr.valueInd()) + ", fork: " + _network.asString());
 }
 
-void StateTestRunner::performVMTrace(TransactionInGeneralSection& _tr, FH32 const& _remoteStateHash, FORK const& _network)
+void StateTestRunner::performVMTrace(
+    SessionInterface& _session, TransactionInGeneralSection& _tr, FH32 const& _remoteStateHash, FORK const& _network)
 {
     if (Options::get().vmtrace)
     {
         auto const& trHash = _tr.reportedHash();
         string const testNameOut = makeFilename(_tr, _network);
-        VMtraceinfo info(m_session, trHash, _remoteStateHash, testNameOut);
+        VMtraceinfo info(_session, trHash, _remoteStateHash, testNameOut);
         printVmTrace(info);
     }
 }
 
-void StateTestRunner::performPostState(TransactionInGeneralSection& _tr, FORK const& _network, EthGetBlockBy const& _block)
+void StateTestRunner::performPostState(
+    SessionInterface& _session, TransactionInGeneralSection& _tr, FORK const& _network, EthGetBlockBy const& _block)
 {
     if (Options::get().poststate)
     {
-        auto const remStateJson = getRemoteState(m_session)->asDataObject()->asJson();
+        auto const remStateJson = getRemoteState(_session)->asDataObject()->asJson();
         ETH_DC_MESSAGE(DC::STATE,
             "\nRunning test State Dump:" + TestOutputHelper::get().testInfo().errorDebug() + cDefault + " \n" + remStateJson);
         ETH_DC_MESSAGE(DC::STATE, "Reported root: " + _block.header()->stateRoot().asString());
@@ -170,7 +183,7 @@ std::string StateTestRunner::makeFilename(TransactionInGeneralSection& _tr, FORK
     return testNameOut;
 }
 
-void StateTestRunner::performStateDiff(TransactionInGeneralSection const& _tr, FORK const& _network)
+void StateTestRunner::performStateDiff(SessionInterface& _session, TransactionInGeneralSection const& _tr, FORK const& _network)
 {
     auto const& opt = Options::get();
     if (opt.statediff)
@@ -191,9 +204,9 @@ void StateTestRunner::performStateDiff(TransactionInGeneralSection const& _tr, F
             auto& statediffB = std::get<1>(results);
 
             if (opt.statediff.firstFork == _network.asString() && statediffA.isEmpty())
-                statediffA = getRemoteState(m_session);
+                statediffA = getRemoteState(_session);
             if (opt.statediff.seconFork == _network.asString() && statediffB.isEmpty())
-                statediffB = getRemoteState(m_session);
+                statediffB = getRemoteState(_session);
 
             if (!statediffA.isEmpty() && !statediffB.isEmpty())
             {
@@ -207,7 +220,7 @@ void StateTestRunner::performStateDiff(TransactionInGeneralSection const& _tr, F
         }
         else
         {
-            auto const stateDiffJson = stateDiff(m_test.Pre(), getRemoteState(m_session))->asJson();
+            auto const stateDiffJson = stateDiff(m_test.Pre(), getRemoteState(_session))->asJson();
             ETH_DC_MESSAGE(DC::STATE,
                 "\nRunning test State Diff:" + TestOutputHelper::get().testInfo().errorDebug() + cDefault + " \n" + stateDiffJson);
         }
@@ -215,7 +228,8 @@ void StateTestRunner::performStateDiff(TransactionInGeneralSection const& _tr, F
 }
 
 
-void StateTestRunner::performValidations(TransactionInGeneralSection& _tr, StateTestPostResult const& _result)
+void StateTestRunner::performValidations(
+    SessionInterface& _session, TransactionInGeneralSection& _tr, StateTestPostResult const& _result)
 {
     // Validate that txbytes field has the transaction data described in test `transaction` field.
     spBYTES const& expectedBytesPtr = _result.txbytesPtr();
@@ -253,7 +267,7 @@ void StateTestRunner::performValidations(TransactionInGeneralSection& _tr, State
     if (Options::getDynamicOptions().getCurrentConfig().cfgFile().checkLogsHash())
     {
         FH32 const& expectedLogHash = _result.logs();
-        FH32 remoteLogHash(m_session.test_getLogHash(_tr.reportedHash()));
+        FH32 remoteLogHash(_session.test_getLogHash(_tr.reportedHash()));
         if (remoteLogHash != expectedLogHash)
             ETH_ERROR_MESSAGE(
                 "Logs hash mismatch: '" + remoteLogHash.asString() + "', expected: '" + expectedLogHash.asString() + "'");
@@ -322,4 +336,84 @@ bool optionsAllowTransaction(TransactionInGeneralSection const& _tr)
 }
 
 
+bool canShareTransactions(bool _hasBigInt, bool _hasUnitTestExceptions)
+{
+    Options const& opt = Options::get();
+    return opt.threadCount > 1 && !_hasBigInt && !_hasUnitTestExceptions && !opt.vmtrace && !opt.poststate && !opt.statediff;
+}
+
+SharedTestSessions::SharedTestSessions(PrepareFunc _prepare)
+  : m_prepare(_prepare),
+    m_testThread(TestOutputHelper::getThreadID()),
+    m_testName(TestOutputHelper::get().testName()),
+    m_testFile(TestOutputHelper::get().testFile())
+{}
+
+void SharedTestSessions::attach()
+{
+    thread::id const threadID = TestOutputHelper::getThreadID();
+    if (threadID == m_testThread)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_helpers.count(threadID))
+            return;
+
+        // Keep the helper's own test output state to restore it on release
+        HelperState& state = m_helpers[threadID];
+        state.testName = TestOutputHelper::get().testName();
+        state.testFile = TestOutputHelper::get().testFile();
+        state.testInfo = TestOutputHelper::get().testInfo();
+    }
+    TestOutputHelper::get().setCurrentTestName(m_testName);
+    TestOutputHelper::get().setCurrentTestFile(m_testFile);
+    RPCSession::sessionStart(threadID);
+}
+
+SessionInterface& SharedTestSessions::session(FORK const& _network)
+{
+    attach();
+    thread::id const threadID = TestOutputHelper::getThreadID();
+    bool const helper = threadID != m_testThread;
+    string preparedFork;
+    if (helper)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        preparedFork = m_helpers.at(threadID).preparedFork;
+    }
+    else
+        preparedFork = m_testThreadFork;
+
+    SessionInterface& session = RPCSession::instance(threadID);
+    if (preparedFork == _network.asString())
+        return session;
+    m_prepare(session, _network);
+    if (helper)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_helpers.at(threadID).preparedFork = _network.asString();
+    }
+    else
+        m_testThreadFork = _network.asString();
+    return session;
+}
+
+void SharedTestSessions::release()
+{
+    thread::id const threadID = TestOutputHelper::getThreadID();
+    HelperState state;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto const helper = m_helpers.find(threadID);
+        if (helper == m_helpers.end())
+            return;
+        state = helper->second;
+        m_helpers.erase(helper);
+    }
+    RPCSession::sessionEnd(threadID, RPCSession::SessionStatus::HasFinished);
+    TestOutputHelper::get().setCurrentTestName(state.testName);
+    TestOutputHelper::get().setCurrentTestFile(state.testFile);
+    TestOutputHelper::get().setCurrentTestInfo(state.testInfo);
+}
+
 }
@@ -16,12 +16,19 @@ public:
     std::vector<TransactionInGeneralSection>& txs() { return m_txs; }
     void setTransactionInfo(TransactionInGeneralSection& _tr, FORK const& _network);
     void performTransactionOnResult(TransactionInGeneralSection&, StateTestPostResult const&, FORK const&);
+
+    // Execute the transaction on any worker session
+    void setChainParams(test::session::SessionInterface&, FORK const&) const;
+    void performTransactionOnResult(
+        test::session::SessionInterface&, TransactionInGeneralSection&, StateTestPostResult const&, FORK const&);
 private:
     std::vector<TransactionInGeneralSection> buildTransactionsWithLabels();
-    void performVMTrace(TransactionInGeneralSection& _tr, FH32 const& _remoteStateHash, FORK const& _network);
-    void performPostState(TransactionInGeneralSection& _tr, FORK const& _network, EthGetBlockBy const&);
-    void performStateDiff(TransactionInGeneralSection const& _tr, FORK const& _netwrok);
-    void performValidations(TransactionInGeneralSection& _tr, StateTestPostResult const& _result);
+    void performVMTrace(test::session::SessionInterface&, TransactionInGeneralSection& _tr, FH32 const& _remoteStateHash,
+        FORK const& _network);
+    void performPostState(test::session::SessionInterface&, TransactionInGeneralSection& _tr, FORK const& _network,
+        EthGetBlockBy const&);
+    void performStateDiff(test::session::SessionInterface&, TransactionInGeneralSection const& _tr, FORK const& _netwrok);
+    void performValidations(test::session::SessionInterface&, TransactionInGeneralSection& _tr, StateTestPostResult const& _result);
     std::string makeFilename(TransactionInGeneralSection& _tr, FORK const& _network);
 private:
     StateTestInFilled const& m_test;
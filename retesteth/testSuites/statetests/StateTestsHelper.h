@@ -1,7 +1,11 @@
 #pragma once
+#include <retesteth/helpers/TestInfo.h>
 #include <retesteth/session/Session.h>
 #include <retesteth/testStructures/structures.h>
 #include <retesteth/testSuiteRunner/TestSuite.h>
+#include <map>
+#include <mutex>
+#include <thread>
 
 namespace test::statetests
 {
@@ -21,4 +25,40 @@ spDataObject FillTestAsBlockchain(StateTestInFiller const& _test, TestSuite::Tes
 void checkUnexecutedTransactions(std::vector<TransactionInGeneralSection> const&, Report _report = Report::WARNING);
 bool optionsAllowTransaction(TransactionInGeneralSection const& _tr);
 
+// Whether (fork, transaction) runs of one test file can be spread over worker sessions with ThreadManager::runShared
+// Debug output must come in order and expected exceptions are tracked by the test thread
+bool canShareTransactions(bool _hasBigInt, bool _hasUnitTestExceptions);
+
+// Sessions of the threads executing transactions of one test, with chain params set for the fork of the transaction
+class SharedTestSessions
+{
+public:
+    typedef std::function<void(test::session::SessionInterface&, FORK const&)> PrepareFunc;
+    SharedTestSessions(PrepareFunc _prepare);
+    test::session::SessionInterface& session(FORK const& _network);
+
+    // Start the session of a helper thread and report its errors for this test, does nothing on the test thread
+    void attach();
+
+    // Called on a helper thread when it is done with the test, ends its session and restores its test output state
+    void release();
+
+private:
+    struct HelperState
+    {
+        std::string testName;
+        boost::filesystem::path testFile;
+        TestInfo testInfo;
+        std::string preparedFork;
+    };
+
+    PrepareFunc m_prepare;
+    std::thread::id m_testThread;
+    std::string m_testName;
+    boost::filesystem::path m_testFile;
+    std::mutex m_mutex;
+    std::map<std::thread::id, HelperState> m_helpers;
+    std::string m_testThreadFork;
+};
+
 }  // namespace test::statetests
@@ -22,6 +22,11 @@
 #include <retesteth/helpers/TestHelper.h>
 #include <retesteth/helpers/TestOutputHelper.h>
 #include <retesteth/testSuites/Common.h>
+#include <retesteth/session/ToolBackend/GenesisRootCache.h>
+#include <retesteth/session/ToolBackend/ToolChainHelper.h>
+#include <libdevcore/TrieHash.h>
+#include <chrono>
+#include <thread>
 
 using namespace std;
 using namespace dev;
@@ -594,4 +599,346 @@ BOOST_AUTO_TEST_CASE(clientconfigTest)
     BOOST_CHECK(cfg.socketAdresses().at(1).asString() == "127.0.0.1:8546");
 }
 
+BOOST_AUTO_TEST_CASE(restoreStateFromDiff)
+{
+    string const preStr = R"({
+        "0x1000000000000000000000000000000000000000" : {"balance" : "0x01", "code" : "0x", "nonce" : "0x00", "storage" : {}},
+        "0x2000000000000000000000000000000000000000" : {"balance" : "0x02", "code" : "0x", "nonce" : "0x00", "storage" : {}},
+        "0x3000000000000000000000000000000000000000" : {"balance" : "0x03", "code" : "0x", "nonce" : "0x00", "storage" : {}}
+    })";
+    string const diffStr = R"({
+        "0x2000000000000000000000000000000000000000" : {"balance" : "0x20", "storage" : {"0x01" : "0x0002"}},
+        "0x3000000000000000000000000000000000000000" : null,
+        "0x4000000000000000000000000000000000000000" : {"nonce" : "0x01"}
+    })";
+    spState pre = toolimpl::restoreFullState(ConvertJsoncppStringToData(preStr).getContent());
+    spState post = toolimpl::restoreStateFromDiff(pre, ConvertJsoncppStringToData(diffStr).getContent());
+
+    BOOST_CHECK_EQUAL(post->accountCount(), 3u);
+    FH20 const acc1("0x1000000000000000000000000000000000000000");
+    FH20 const acc2("0x2000000000000000000000000000000000000000");
+    BOOST_CHECK(&post->getAccount(acc1) == &pre->getAccount(acc1));
+    BOOST_CHECK(post->getAccount(acc2).balance().asString() == "0x20");
+    BOOST_CHECK(post->getAccount(acc2).storage().atKey(VALUE(1)).asString() == "0x02");
+    BOOST_CHECK(!post->hasAccount(FH20("0x3000000000000000000000000000000000000000")));
+    BOOST_CHECK(post->getAccount(FH20("0x4000000000000000000000000000000000000000")).nonce().asString() == "0x01");
+    BOOST_CHECK(pre->getAccount(acc2).balance().asString() == "0x02");
+}
+
+BOOST_AUTO_TEST_CASE(restoreStateOverlay_chain)
+{
+    string const preStr = R"({
+        "0x1000000000000000000000000000000000000000" : {"balance" : "0x01", "code" : "0x", "nonce" : "0x00", "storage" : {"0x01" : "0x01"}},
+        "0x2000000000000000000000000000000000000000" : {"balance" : "0x02", "code" : "0x", "nonce" : "0x00", "storage" : {}}
+    })";
+    spState const genesis = toolimpl::restoreFullState(ConvertJsoncppStringToData(preStr).getContent());
+    FH20 const acc1("0x1000000000000000000000000000000000000000");
+    FH20 const acc2("0x2000000000000000000000000000000000000000");
+
+    // Every block bumps acc2 balance, acc1 stays the same object through the chain
+    spState state = genesis;
+    for (int i = 1; i <= 40; i++)
+    {
+        spDataObject post = genesis->asDataObject();
+        (*post)[acc2.asString()]["balance"] = VALUE(i + 2).asString();
+        state = toolimpl::restoreStateOverlay(state, post.getContent());
+        BOOST_CHECK(state->getAccount(acc2).balance() == VALUE(i + 2));
+        BOOST_CHECK(&state->getAccount(acc1) == &genesis->getAccount(acc1));
+        BOOST_CHECK(state->accountCount() == 2);
+    }
+
+    // Account removed by the tool
+    spDataObject post = state->asDataObject();
+    (*post).removeKey(acc1.asString());
+    spState const last = toolimpl::restoreStateOverlay(state, post.getContent());
+    BOOST_CHECK(!last->hasAccount(acc1));
+    BOOST_CHECK(state->hasAccount(acc1));
+    BOOST_CHECK_EQUAL(last->accountCount(), 1u);
+    BOOST_CHECK_EQUAL(state->accountCount(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(stateOverlay_forEachAccount)
+{
+    string const preStr = R"({
+        "0x1000000000000000000000000000000000000000" : {"balance" : "0x01", "code" : "0x", "nonce" : "0x00", "storage" : {}},
+        "0x3000000000000000000000000000000000000000" : {"balance" : "0x03", "code" : "0x", "nonce" : "0x00", "storage" : {}}
+    })";
+    string const diff1Str = R"({
+        "0x2000000000000000000000000000000000000000" : {"balance" : "0x02"},
+        "0x3000000000000000000000000000000000000000" : null
+    })";
+    string const diff2Str = R"({
+        "0x1000000000000000000000000000000000000000" : {"balance" : "0x10"},
+        "0x3000000000000000000000000000000000000000" : {"balance" : "0x30"}
+    })";
+    spState const pre = toolimpl::restoreFullState(ConvertJsoncppStringToData(preStr).getContent());
+    spState const post1 = toolimpl::restoreStateFromDiff(pre, ConvertJsoncppStringToData(diff1Str).getContent());
+    spState const post2 = toolimpl::restoreStateFromDiff(post1, ConvertJsoncppStringToData(diff2Str).getContent());
+
+    std::vector<string> visited;
+    post1->forEachAccount([&visited](FH20 const& _address, spAccountBase const& _acc) {
+        visited.emplace_back(_address.asString() + ":" + _acc->balance().asString());
+    });
+    BOOST_REQUIRE_EQUAL(visited.size(), 2u);
+    BOOST_CHECK_EQUAL(visited.at(0), "0x1000000000000000000000000000000000000000:0x01");
+    BOOST_CHECK_EQUAL(visited.at(1), "0x2000000000000000000000000000000000000000:0x02");
+
+    // Account deleted in the parent and created again, the nearest state wins
+    visited.clear();
+    post2->forEachAccount([&visited](FH20 const& _address, spAccountBase const& _acc) {
+        visited.emplace_back(_address.asString() + ":" + _acc->balance().asString());
+    });
+    BOOST_REQUIRE_EQUAL(visited.size(), 3u);
+    BOOST_CHECK_EQUAL(visited.at(0), "0x1000000000000000000000000000000000000000:0x10");
+    BOOST_CHECK_EQUAL(visited.at(1), "0x2000000000000000000000000000000000000000:0x02");
+    BOOST_CHECK_EQUAL(visited.at(2), "0x3000000000000000000000000000000000000000:0x30");
+    BOOST_CHECK_EQUAL(post2->accountCount(), 3u);
+    BOOST_CHECK_EQUAL(post2->asDataObject()->getSubObjects().size(), 3u);
+
+    // Range iteration seeks to the start address and stops when asked
+    visited.clear();
+    post2->forEachAccountFrom(FH20("0x1000000000000000000000000000000000000001"),
+        [&visited](FH20 const& _address, spAccountBase const& _acc) {
+            visited.emplace_back(_address.asString() + ":" + _acc->balance().asString());
+            return false;
+        });
+    BOOST_REQUIRE_EQUAL(visited.size(), 1u);
+    BOOST_CHECK_EQUAL(visited.at(0), "0x2000000000000000000000000000000000000000:0x02");
+}
+
+namespace
+{
+spState makeDumpBenchmarkState(size_t _accounts, size_t _slots)
+{
+    spDataObject data(new DataObject(DataType::Object));
+    for (size_t i = 1; i <= _accounts; i++)
+    {
+        string const addr = "0x" + dev::toHex(dev::h160(i));
+        DataObject& acc = (*data)[addr];
+        acc["balance"] = VALUE(dev::bigint(i) * 1000000007).asString();
+        acc["nonce"] = VALUE(int(i % 100)).asString();
+        acc["code"] = "0x6001600055";
+        spDataObject storage(new DataObject(DataType::Object));
+        for (size_t k = 1; k <= _slots; k++)
+            (*storage)[VALUE(int(k)).asString()] = VALUE(dev::bigint(i * k) << 128).asString();
+        acc.atKeyPointer("storage") = storage;
+    }
+    return spState(new State(dataobject::move(data)));
+}
+
+// Every thread dumps the same shared state, as worker threads do with shared test structures
+double runStateDumps(State const& _state, size_t _threads, size_t _dumpsPerThread)
+{
+    auto const start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < _threads; t++)
+        threads.emplace_back([&_state, _dumpsPerThread]() {
+            for (size_t i = 0; i < _dumpsPerThread; i++)
+                _state.asDataObject();
+        });
+    for (auto& th : threads)
+        th.join();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(valueCacheConcurrentAccess)
+{
+    // First access of caches happens concurrently from many threads
+    for (size_t round = 0; round < 20; round++)
+    {
+        spVALUE value(new VALUE(dev::bigint(round + 1) << 200));
+        spFH32 hash(new FH32("0x" + dev::toHex(dev::h256(round + 1))));
+        string const expValue = VALUE(dev::bigint(round + 1) << 200).asString();
+        string const expHash = "0x" + dev::toHex(dev::h256(round + 1));
+        std::atomic<size_t> mismatches = 0;
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < 8; t++)
+            threads.emplace_back([&]() {
+                if (value->asString() != expValue || value->serializeRLP().empty())
+                    mismatches++;
+                if (hash->asString() != expHash || hash->serializeRLP().size() != 32)
+                    mismatches++;
+            });
+        for (auto& th : threads)
+            th.join();
+        BOOST_CHECK(mismatches == 0);
+    }
+}
+
+// Benchmark: ./retesteth -t EthObjectsSuite/stateDumpScaling
+BOOST_AUTO_TEST_CASE(stateDumpScaling, *boost::unit_test::disabled())
+{
+    spState const state = makeDumpBenchmarkState(500, 20);
+    size_t const dumps = 20;
+    runStateDumps(state, 1, 1);  // warm up the caches
+    double const single = runStateDumps(state, 1, dumps);
+    for (size_t threads : {2, 4, 8, 16})
+    {
+        double const multi = runStateDumps(state, threads, dumps);
+        ETH_STDOUT_MESSAGE("stateDumpScaling -j" + test::fto_string(threads) + ": " + test::fto_string(multi) + "s, " +
+                           "throughput x" + test::fto_string(threads * single / multi) + " of -j1 " + test::fto_string(single) + "s");
+    }
+}
+
+// Benchmark: ./retesteth -t EthObjectsSuite/stateHashBenchmark
+BOOST_AUTO_TEST_CASE(stateHashBenchmark, *boost::unit_test::disabled())
+{
+    spState const state = makeDumpBenchmarkState(500, 20);
+    spDataObject const dump = state->asDataObject();
+    size_t const rounds = 20;
+
+    auto const start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < rounds; i++)
+    {
+        spDataObject data = dump->copy();
+        State const st(dataobject::move(data));
+    }
+    auto const afterConstruction = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < rounds; i++)
+        test::compareStates(*state, *state);
+    auto const afterComparison = std::chrono::steady_clock::now();
+
+    std::chrono::duration<double> const construction = afterConstruction - start;
+    std::chrono::duration<double> const comparison = afterComparison - afterConstruction;
+    ETH_STDOUT_MESSAGE("stateHashBenchmark construction: " + test::fto_string(construction.count()) +
+                       "s, compareStates: " + test::fto_string(comparison.count()) + "s, rounds: " + test::fto_string(rounds));
+}
+
+BOOST_AUTO_TEST_CASE(ethashDifficulty_forkParams)
+{
+    using namespace toolimpl;
+    auto const difficulty = [](string const& _fork, bigint _number, bigint _timestamp, bool _uncles) {
+        ChainOperationParams params;
+        BOOST_REQUIRE(ChainOperationParams::forkParams(FORK(_fork), params));
+        return calculateEthashDifficulty(params, _number, _timestamp, _number - 1, 0, 0x100000, _uncles).asBigInt();
+    };
+    BOOST_CHECK_EQUAL(difficulty("Frontier", 1, 10, false), 1049088);
+    BOOST_CHECK_EQUAL(difficulty("Homestead", 1, 25, false), 1048064);
+    BOOST_CHECK_EQUAL(difficulty("Byzantium", 1, 9, true), 1049088);
+
+    // Ice age of Byzantium is delayed by 3M blocks, of London by 9.7M
+    BOOST_CHECK_EQUAL(difficulty("Byzantium", 5000001, 9, false), 1048576 + 262144);
+    BOOST_CHECK_EQUAL(difficulty("London", 5000001, 9, false), 1048576);
+    BOOST_CHECK_EQUAL(difficulty("GrayGlacier", 11500000, 9, false), 1048576);
+
+    ChainOperationParams params;
+    BOOST_CHECK(!ChainOperationParams::forkParams(FORK("Paris"), params));
+}
+
+BOOST_AUTO_TEST_CASE(testRawTransaction_asDataObject)
+{
+    string const accepted = R"({
+        "result" : true,
+        "acceptedTransactions" : [{
+            "sender" : "0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b",
+            "hash" : "0x0f3b10f7adb0e2e6a9c5b8b1ea0c2e7c68d3f2e3c1a1f2d1e1e2a3b4c5d6e7f8",
+            "intrinsicGas" : "0x5208"
+        }]
+    })";
+    TestRawTransaction const acc(dataobject::ConvertJsoncppStringToData(accepted).getCContent());
+    TestRawTransaction const accCopy(acc.asDataObject().getCContent());
+    BOOST_CHECK(accCopy.error().empty());
+    BOOST_CHECK(accCopy.sender() == acc.sender());
+    BOOST_CHECK(accCopy.trhash() == acc.trhash());
+    BOOST_CHECK(accCopy.intrinsicGas() == acc.intrinsicGas());
+
+    string const rejected = R"({
+        "result" : true,
+        "rejectedTransactions" : [{
+            "error" : "intrinsic gas too low",
+            "sender" : "0x0000000000000000000000000000000000000000",
+            "hash" : "0x0f3b10f7adb0e2e6a9c5b8b1ea0c2e7c68d3f2e3c1a1f2d1e1e2a3b4c5d6e7f8",
+            "intrinsicGas" : "0x5208"
+        }]
+    })";
+    TestRawTransaction const rej(dataobject::ConvertJsoncppStringToData(rejected).getCContent());
+    TestRawTransaction const rejCopy(rej.asDataObject().getCContent());
+    BOOST_CHECK_EQUAL(rejCopy.error(), "intrinsic gas too low");
+    BOOST_CHECK_EQUAL(rejCopy.getTrException(rej.trhash()), "intrinsic gas too low");
+    BOOST_CHECK(rejCopy.intrinsicGas() == rej.intrinsicGas());
+}
+
+BOOST_AUTO_TEST_CASE(trieRoot_knownVectors)
+{
+    auto const asBytes = [](string const& _str) { return bytes(_str.begin(), _str.end()); };
+    BOOST_CHECK_EQUAL(EmptyTrie.hex(), "56e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421");
+    BOOST_CHECK(trieRoot(BytesMap()) == EmptyTrie);
+
+    BytesMap data;
+    data[asBytes("doe")] = asBytes("reindeer");
+    data[asBytes("dog")] = asBytes("puppy");
+    data[asBytes("dogglesworth")] = asBytes("cat");
+    BOOST_CHECK_EQUAL(trieRoot(data).hex(), "8aad789dff2f538bca5d8ea56e8abe10f4c7ba3a5dea95fea4cd6e7c3a1168d3");
+
+    data.clear();
+    data[asBytes("do")] = asBytes("verb");
+    data[asBytes("dog")] = asBytes("puppy");
+    data[asBytes("doge")] = asBytes("coin");
+    data[asBytes("horse")] = asBytes("stallion");
+    BOOST_CHECK_EQUAL(trieRoot(data).hex(), "5991bb8c6514148a29db676a14ac506cd2cd5775ace63c30a4fe457715e9ac84");
+}
+
+BOOST_AUTO_TEST_CASE(calculateStateRoot_native)
+{
+    auto const stateRoot = [](string const& _state, FH32& _root) {
+        spDataObject data = ConvertJsoncppStringToData(_state);
+        return toolimpl::calculateStateRoot(State(dataobject::move(data)), _root);
+    };
+
+    FH32 root(FH32::zero());
+    BOOST_CHECK(stateRoot("{}", root));
+    BOOST_CHECK(root == FH32("0x" + EmptyTrie.hex()));
+
+    // Genesis and post state of bcExample/optionsTest (London) as filled by geth
+    BOOST_CHECK(stateRoot(R"({
+        "0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b" : {"balance" : "0x016345785d8a0000", "code" : "0x", "nonce" : "0x00", "storage" : {}},
+        "0xb94f5374fce5edbc8e2a8697c15331677e6ebf0b" : {"balance" : "0x016345785d8a0000", "code" : "0x60016000355500", "nonce" : "0x00", "storage" : {}}})",
+        root));
+    BOOST_CHECK(root == FH32("0xa82e8b1e48c59bbd435fb1d61d8be0068e05172dfb9681bc5e4c419401e23a29"));
+    BOOST_CHECK(stateRoot(R"({
+        "0x2adc25665018aa1fe0e6bc666dac8fc2697ff9ba" : {"balance" : "0x6f05b59d3ca4b27d", "code" : "0x", "nonce" : "0x00", "storage" : {}},
+        "0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b" : {"balance" : "0x016345785be3a580", "code" : "0x", "nonce" : "0x04", "storage" : {}},
+        "0xb94f5374fce5edbc8e2a8697c15331677e6ebf0b" : {"balance" : "0x016345785d8a0000", "code" : "0x60016000355500", "nonce" : "0x00",
+            "storage" : {"0x01" : "0x01", "0x02" : "0x01", "0x03" : "0x01", "0x05" : "0x01"}}})",
+        root));
+    BOOST_CHECK(root == FH32("0x341ff296dfc16b4b6c16eae2cb6ee46e6baf88a435c591fdc26f0acf3b7630dc"));
+
+    // Zero storage values are not part of the storage trie
+    FH32 withZeroSlot(FH32::zero());
+    BOOST_CHECK(stateRoot(R"({"0x095e7baea6a6c7c4c2dfeb977efac326af552d87" : {
+        "balance" : "0x0de0b6b3a7640000", "nonce" : "0x00", "code" : "0x6001600055", "storage" : {"0x01" : "0x00"}}})", withZeroSlot));
+    BOOST_CHECK(stateRoot(R"({"0x095e7baea6a6c7c4c2dfeb977efac326af552d87" : {
+        "balance" : "0x0de0b6b3a7640000", "nonce" : "0x00", "code" : "0x6001600055", "storage" : {}}})", root));
+    BOOST_CHECK(root == withZeroSlot);
+    BOOST_CHECK(root != FH32("0x" + EmptyTrie.hex()));
+
+    // Malicious encodings are left for the tool
+    BOOST_CHECK(!stateRoot(R"({"0x095e7baea6a6c7c4c2dfeb977efac326af552d87" : {
+        "balance" : "0x:bigint 0x00", "nonce" : "0x00", "code" : "0x", "storage" : {}}})", root));
+}
+
+BOOST_AUTO_TEST_CASE(genesisRootCache_key)
+{
+    auto const makeKey = [](string const& _state, string const& _tool) {
+        spDataObject data = ConvertJsoncppStringToData(_state);
+        return toolimpl::GenesisRootCache::makeKey(State(dataobject::move(data)), _tool);
+    };
+    string const accA = R"("0x095e7baea6a6c7c4c2dfeb977efac326af552d87" : {"balance" : "0x01", "nonce" : "0x00", "code" : "0x", "storage" : {}})";
+    string const accB = R"("0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b" : {"balance" : "0x0de0b6b3a7640000", "nonce" : "0x00", "code" : "0x", "storage" : {"0x01" : "0x02"}})";
+
+    string const key = makeKey("{" + accA + "," + accB + "}", "t8n");
+    BOOST_CHECK_EQUAL(key, makeKey("{" + accB + "," + accA + "}", "t8n"));
+    BOOST_CHECK(key != makeKey("{" + accA + "}", "t8n"));
+    BOOST_CHECK(key != makeKey("{" + accA + "," + accB + "}", "evm"));
+
+    FH32 root(FH32::zero());
+    auto& cache = toolimpl::GenesisRootCache::get();
+    BOOST_CHECK(!cache.find(key, root));
+    FH32 const expected("0x" + EmptyTrie.hex());
+    cache.record(key, expected);
+    BOOST_CHECK(cache.find(key, root));
+    BOOST_CHECK(root == expected);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,6 +1,11 @@
+#include <libdevcore/CommonIO.h>
 #include <retesteth/EthChecks.h>
+#include <retesteth/compiler/CompileCache.h>
+#include <retesteth/compiler/Compiler.h>
+#include <retesteth/configs/Options.h>
 #include <retesteth/helpers/TestHelper.h>
 #include <retesteth/helpers/TestOutputHelper.h>
+#include <boost/filesystem.hpp>
 
 using namespace std;
 using namespace dev;
@@ -154,4 +159,91 @@ BOOST_AUTO_TEST_CASE(solc_abi_IntegerAndAddress)
                      "000000000000000000000000cd2a3d9f938e13cd947ec05abc7fe734df8dd826");
 }
 
+BOOST_AUTO_TEST_CASE(solc_evmVersionArg)
+{
+    string const code = "// RETESTETH_SOLC_EVM_VERSION=berlin\npragma solidity >=0.8.5;\ncontract C {}";
+    BOOST_CHECK_EQUAL(test::compiler::utiles::solcEvmVersionArg(code), "--evm-version berlin");
+    BOOST_CHECK_EQUAL(test::compiler::utiles::solcEvmVersionArg("pragma solidity >=0.8.5;\ncontract C {}"), "");
+}
+
+BOOST_AUTO_TEST_CASE(solc_standardJsonInput)
+{
+    utiles::StandardJsonBatch yul;
+    yul.language = "Yul";
+    yul.evmVersion = "london";
+    yul.optimize = true;
+    yul.sources = {"{ sstore(0, 1) }", "{ sstore(1, 2) }"};
+    spDataObject const yulInput = utiles::makeStandardJsonInput(yul);
+    BOOST_CHECK_EQUAL(yulInput->atKey("language").asString(), "Yul");
+    BOOST_CHECK_EQUAL(yulInput->atKey("sources").getSubObjects().size(), 2u);
+    BOOST_CHECK_EQUAL(yulInput->atKey("sources").atKey("s0").atKey("content").asString(), "{ sstore(0, 1) }");
+    BOOST_CHECK_EQUAL(yulInput->atKey("sources").atKey("s1").atKey("content").asString(), "{ sstore(1, 2) }");
+
+    // As yul.sh: solc --evm-version london --strict-assembly --optimize --yul-optimizations=":"
+    DataObject const& settings = yulInput->atKey("settings");
+    BOOST_CHECK_EQUAL(settings.atKey("evmVersion").asString(), "london");
+    BOOST_CHECK(settings.atKey("optimizer").atKey("enabled").asBool());
+    BOOST_CHECK(settings.atKey("optimizer").atKey("details").atKey("yul").asBool());
+    BOOST_CHECK_EQUAL(
+        settings.atKey("optimizer").atKey("details").atKey("yulDetails").atKey("optimizerSteps").asString(), ":");
+    auto const& yulOutput = settings.atKey("outputSelection").atKey("*").atKey("*").getSubObjects();
+    BOOST_REQUIRE_EQUAL(yulOutput.size(), 1u);
+    BOOST_CHECK_EQUAL(yulOutput.at(0)->asString(), "evm.bytecode.object");
+
+    // As compileSolidity: solc --bin-runtime without optimizer
+    utiles::StandardJsonBatch solidity;
+    solidity.language = "Solidity";
+    solidity.sources = {"pragma solidity >=0.4.0; contract A {}"};
+    spDataObject const solidityInput = utiles::makeStandardJsonInput(solidity);
+    DataObject const& soliditySettings = solidityInput->atKey("settings");
+    BOOST_CHECK(!soliditySettings.count("evmVersion"));
+    BOOST_CHECK(!soliditySettings.atKey("optimizer").atKey("enabled").asBool());
+    BOOST_CHECK(!soliditySettings.atKey("optimizer").count("details"));
+    auto const& solidityOutput = soliditySettings.atKey("outputSelection").atKey("*").atKey("*").getSubObjects();
+    BOOST_REQUIRE_EQUAL(solidityOutput.size(), 1u);
+    BOOST_CHECK_EQUAL(solidityOutput.at(0)->asString(), "evm.deployedBytecode.object");
+}
+
+BOOST_AUTO_TEST_CASE(solc_standardJsonBatchMatchesYulScript)
+{
+    if (!test::checkCmdExist("solc"))
+    {
+        BOOST_TEST_MESSAGE("solc not found, skipping solc_standardJsonBatchMatchesYulScript");
+        return;
+    }
+
+    namespace fs = boost::filesystem;
+    fs::path const dir = fs::temp_directory_path() / fs::unique_path();
+    fs::create_directories(dir);
+    fs::path const script = dir / "yul.sh";
+    writeFile(script, retesteth::options::yul_compiler_sh);
+    fs::permissions(script, fs::owner_all);
+
+    utiles::StandardJsonBatch batch;
+    batch.language = "Yul";
+    batch.evmVersion = "london";
+    batch.optimize = true;
+    batch.sources = {"{ sstore(0, add(1, 2)) }", "{ let a := calldataload(0) sstore(a, mul(a, 2)) }"};
+    vector<string> expected;
+    for (size_t i = 0; i < batch.sources.size(); i++)
+    {
+        fs::path const source = dir / ("s" + to_string(i) + ".yul");
+        writeFile(source, batch.sources.at(i));
+        int exitCode;
+        expected.emplace_back(test::executeCmd(script.string() + " " + source.string() + " london", exitCode));
+        string const compilerId = "batch test " + fs::unique_path().string();
+        batch.cacheKeys.emplace_back(CompileCache::makeKey(compilerId, "", batch.sources.at(i)));
+    }
+
+    // Batch results are cached under the key of the yul.sh call, so they must be what yul.sh returns
+    utiles::compileStandardJsonBatch(batch);
+    for (size_t i = 0; i < batch.sources.size(); i++)
+    {
+        string compiled;
+        BOOST_REQUIRE(CompileCache::get().find(batch.cacheKeys.at(i), compiled));
+        BOOST_CHECK_EQUAL(compiled, expected.at(i));
+    }
+    fs::remove_all(dir);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
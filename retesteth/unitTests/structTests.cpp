@@ -374,6 +374,43 @@ BOOST_AUTO_TEST_CASE(valueb_oversize)
     checkSerializeBigint(a, "0xe2a1ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff");
 }
 
+BOOST_AUTO_TEST_CASE(value_u256Boundaries)
+{
+    VALUE const max(string("0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"));
+    VALUE const overflow = max + VALUE(1);
+    BOOST_CHECK(overflow.asString() == "0x010000000000000000000000000000000000000000000000000000000000000000");
+    BOOST_CHECK(overflow > max);
+    BOOST_CHECK(overflow - VALUE(1) == max);
+
+    VALUE const negative = VALUE(1) - VALUE(2);
+    BOOST_CHECK(negative.asDecString() == "-1");
+    BOOST_CHECK(negative < VALUE(0));
+    BOOST_CHECK(VALUE(5) - VALUE(2) == VALUE(3));
+    BOOST_CHECK(VALUE(string("0xABCD")).asString() == "0xabcd");
+    BOOST_CHECK(VALUE(string("0xABCD")).asBigInt() == 0xabcd);
+}
+
+BOOST_AUTO_TEST_CASE(value_copyKeepsCache)
+{
+    VALUE const a(string("0x:bigint 0x000122"));
+    BOOST_CHECK(a.asString() == "0x:bigint 0x000122");
+    VALUE const b(a);
+    BOOST_CHECK(b.asString() == "0x:bigint 0x000122");
+    BOOST_CHECK(b.serializeRLP() == a.serializeRLP());
+
+    VALUE c(5);
+    c = b;
+    BOOST_CHECK(c.asString() == "0x:bigint 0x000122");
+    c += 1;
+    BOOST_CHECK(c.asBigInt() == 0x0123);
+    BOOST_CHECK(b.asString() == "0x:bigint 0x000122");
+
+    VALUE const d(string("0x0100"));
+    VALUE const e(d);
+    BOOST_CHECK(e.asString() == "0x0100");
+    BOOST_CHECK(e.asBigInt() == 256);
+}
+
 
 // HASH FUNCTIONS
 BOOST_AUTO_TEST_CASE(hash32)
@@ -425,6 +462,26 @@ BOOST_AUTO_TEST_CASE(hash32_bigint)
     checkSerializeBigint(FH32("0x:bigint 0x00"), "0xc100");
 }
 
+BOOST_AUTO_TEST_CASE(hash_binaryCompare)
+{
+    FH32 const a("0x00000000000000000000000000000000000000000000000000000000000000ff");
+    FH32 const b("0x0000000000000000000000000000000000000000000000000000000000000100");
+    FH32 const aUpper("0x00000000000000000000000000000000000000000000000000000000000000FF");
+    BOOST_CHECK(a == aUpper);
+    BOOST_CHECK(a != b);
+    BOOST_CHECK(a < b && !(b < a));
+    BOOST_CHECK(a.asString() == "0x00000000000000000000000000000000000000000000000000000000000000ff");
+    BOOST_CHECK(FH32::zero().isZero());
+    BOOST_CHECK(!a.isZero());
+
+    // Copies keep the value, malicious hash of wrong size is not equal to the correct one
+    spFH32 const copy(a.copy());
+    BOOST_CHECK(copy->asString() == a.asString());
+    BOOST_CHECK(FH32("0x:bigint 0x00000000000000000000000000000000000000000000000000000000000000ff") == a);
+    BOOST_CHECK(FH32("0x:bigint 0x0000000000000000000000000000000000000000000000000000000000000000ff") != a);
+    BOOST_CHECK(FH20("0x00000000000000000000000000000000000000ff").asStringBytes() == "0x00000000000000000000000000000000000000ff");
+}
+
 
 BOOST_AUTO_TEST_CASE(hash_serialization)
 {
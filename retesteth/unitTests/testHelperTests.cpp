@@ -21,11 +21,25 @@
 #include <libdevcore/CommonIO.h>
 #include <retesteth/EthChecks.h>
 #include <retesteth/Options.h>
+#include <retesteth/compiler/CompileCache.h>
+#include <retesteth/helpers/FillerHashIndex.h>
+#include <retesteth/helpers/PersistentCache.h>
+#include <retesteth/helpers/TestCostCache.h>
 #include <retesteth/helpers/TestHelper.h>
 #include <retesteth/helpers/TestOutputHelper.h>
+#include <retesteth/helpers/TestProfiler.h>
+#include <retesteth/session/Socket.h>
+#include <retesteth/session/ThreadManager.h>
+#include <retesteth/session/ToolBackend/T8NDaemon.h>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <set>
+#include <thread>
 
 using namespace std;
 using namespace dev;
+using namespace dataobject;
 using namespace test;
 
 namespace
@@ -277,4 +291,453 @@ BOOST_AUTO_TEST_CASE(getTestSuggestions2)
     BOOST_CHECK(test::inArray(list, string("BCGeneralStateTests/stExample")));
 }
 
+BOOST_AUTO_TEST_CASE(t8nDaemon_requestRoundTrip)
+{
+    // cat answers every request line with the same line
+    toolimpl::T8NDaemon daemon("/bin/cat", 10);
+    int const pid = daemon.pid();
+    BOOST_CHECK(pid > 0);
+    for (size_t i = 0; i < 3; i++)
+    {
+        string const req = "{\"args\":[\"--state.fork\",\"Cancun\"],\"id\":" + to_string(i) + "}";
+        BOOST_CHECK_EQUAL(daemon.request(req), req);
+    }
+    BOOST_CHECK_EQUAL(daemon.pid(), pid);
+
+    string const large(20000, 'a');
+    BOOST_CHECK_EQUAL(daemon.request(large), large);
+}
+
+BOOST_AUTO_TEST_CASE(t8nDaemon_eofStdioArgs)
+{
+    // Started with arguments like `<tool> eof --state.fork X`, answers a verdict per code line
+    toolimpl::T8NDaemon process("/bin/sed", 10, {"-u", "s/^0xef00.*/OK/;s/^0x[^e].*/err: invalid magic/"});
+    BOOST_CHECK_EQUAL(process.request("0xef0001010004"), "OK");
+    BOOST_CHECK_EQUAL(process.request("0x600000"), "err: invalid magic");
+    BOOST_CHECK_EQUAL(process.request("0xef00"), "OK");
+}
+
+BOOST_AUTO_TEST_CASE(t8nDaemon_timeout)
+{
+    // A daemon that hangs is stopped, the caller falls back to the tool
+    toolimpl::T8NDaemon daemon("/bin/sh", 1, {"-c", "read line; exec sleep 30"});
+    auto const start = std::chrono::steady_clock::now();
+    BOOST_CHECK_THROW(daemon.request("{}"), UpwardsException);
+    BOOST_CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(10));
+    BOOST_CHECK(daemon.timedOut());
+    BOOST_CHECK_EQUAL(daemon.pid(), 0);
+    BOOST_CHECK_THROW(daemon.request("{}"), UpwardsException);
+    BOOST_CHECK_EQUAL(daemon.pid(), 0);
+
+    // A hanging daemon that ignores SIGTERM is killed as well
+    toolimpl::T8NDaemon ignoresTerm("/bin/sh", 1, {"-c", "trap '' TERM; read line; exec sleep 30"});
+    BOOST_CHECK_THROW(ignoresTerm.request("{}"), UpwardsException);
+    BOOST_CHECK_EQUAL(ignoresTerm.pid(), 0);
+    BOOST_CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(10));
+}
+
+BOOST_AUTO_TEST_CASE(t8nDaemon_stopIgnoringTerm)
+{
+    // The daemon is killed after the grace period when it does not exit on SIGTERM
+    auto const start = std::chrono::steady_clock::now();
+    {
+        toolimpl::T8NDaemon daemon("/bin/sh", 10, {"-c", "trap '' TERM; read line; echo $line; exec sleep 30"});
+        BOOST_CHECK_EQUAL(daemon.request("{}"), "{}");
+    }
+    BOOST_CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(10));
+}
+
+BOOST_AUTO_TEST_CASE(executeCmdStdio_roundTrip)
+{
+    int exitCode;
+    string err;
+    string const input(300000, 'a');
+    BOOST_CHECK_EQUAL(test::executeCmdStdio("cat", input, exitCode, err), input);
+    BOOST_CHECK_EQUAL(exitCode, 0);
+    BOOST_CHECK(err.empty());
+
+    string const out = test::executeCmdStdio("cat > /dev/null; echo out; echo err >&2; exit 3", "{}", exitCode, err);
+    BOOST_CHECK_EQUAL(out, "out\n");
+    BOOST_CHECK_EQUAL(err, "err\n");
+    BOOST_CHECK_EQUAL(exitCode, 3);
+}
+
+BOOST_AUTO_TEST_CASE(executeCmd_directAndShell)
+{
+    int exitCode;
+    BOOST_CHECK_EQUAL(test::executeCmd("echo  a   b", exitCode), "a b");
+    BOOST_CHECK_EQUAL(exitCode, 0);
+    BOOST_CHECK_EQUAL(test::executeCmd("echo a | tr a b", exitCode), "b");
+    BOOST_CHECK_EQUAL(exitCode, 0);
+    test::executeCmd("false", exitCode, test::ExecCMDWarning::NoWarningNoError);
+    BOOST_CHECK(exitCode != 0);
+
+    BOOST_CHECK(test::resolveCmdPath("echo a").find("/echo") != string::npos);
+    BOOST_CHECK(test::resolveCmdPath("retesteth_no_such_tool").empty());
+
+    // A script without `#!` line is run by the shell, a directory is not a command
+    namespace fs = boost::filesystem;
+    fs::path const dir = fs::temp_directory_path() / fs::unique_path();
+    fs::create_directories(dir);
+    fs::path const script = dir / "noshebang.sh";
+    writeFile(script, string("echo noshebang $1\n"));
+    fs::permissions(script, fs::owner_all);
+    BOOST_CHECK_EQUAL(test::executeCmd(script.string() + " arg", exitCode), "noshebang arg");
+    BOOST_CHECK_EQUAL(exitCode, 0);
+    BOOST_CHECK(test::resolveCmdPath(dir.string()).empty());
+
+    // An explicit path must be executable, as the commands found in PATH
+    fs::path const notExecutable = dir / "notexecutable.sh";
+    writeFile(notExecutable, string("echo notexecutable\n"));
+    fs::permissions(notExecutable, fs::owner_read | fs::owner_write);
+    BOOST_CHECK(test::resolveCmdPath(notExecutable.string()).empty());
+    fs::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_CASE(jsonStreamScanner_bracketsInStrings)
+{
+    // Two replies in one stream, brackets and escaped quotes in the strings must not split them
+    string const first = R"({"id":1,"error":{"message":"revert: a[0] } \"{["}})";
+    string const second = R"([{"id":2,"result":"0x\\"}])";
+    string const stream = first + second;
+
+    test::session::JsonStreamScanner scanner;
+    std::vector<string> replies;
+    size_t begin = 0;
+    for (size_t i = 0; i < stream.size(); i++)
+    {
+        if (scanner.accept(stream[i]))
+        {
+            replies.emplace_back(stream.substr(begin, i + 1 - begin));
+            begin = i + 1;
+        }
+    }
+    BOOST_REQUIRE_EQUAL(replies.size(), 2u);
+    BOOST_CHECK_EQUAL(replies.at(0), first);
+    BOOST_CHECK_EQUAL(replies.at(1), second);
+
+    test::session::JsonObjectValidator validator;
+    validator.acceptResponse(first.substr(0, 30));
+    BOOST_CHECK(!validator.completeResponse());
+    validator.acceptResponse(first.substr(30));
+    BOOST_CHECK(validator.completeResponse());
+    BOOST_CHECK_EQUAL(validator.getResponse(), first);
+}
+
+BOOST_AUTO_TEST_CASE(testCostCache_longestFirst)
+{
+    namespace fs = boost::filesystem;
+    fs::path const dir = fs::temp_directory_path() / fs::unique_path() / "stCostCache";
+    fs::create_directories(dir);
+    vector<fs::path> fillers;
+    for (auto const& name : {"aFiller.json", "bFiller.json", "cFiller.json", "dFiller.json"})
+        fillers.emplace_back(dir / name);
+    writeFile(fillers.at(0), string(100, 'a'));
+    writeFile(fillers.at(1), string(1000, 'b'));
+    writeFile(fillers.at(2), string(100, 'c'));
+    writeFile(fillers.at(3), string(200, 'd'));
+
+    // no history, bigger files first
+    vector<fs::path> ordered = fillers;
+    TestCostCache::get().orderLongestFirst(ordered);
+    BOOST_CHECK(ordered == vector<fs::path>({fillers.at(1), fillers.at(3), fillers.at(0), fillers.at(2)}));
+
+    // recorded times win over file size, unknown `d` is estimated with the folder's time per byte
+    TestCostCache::get().record(fillers.at(2), 5);
+    TestCostCache::get().record(fillers.at(1), 1);
+    ordered = fillers;
+    TestCostCache::get().orderLongestFirst(ordered);
+    BOOST_CHECK(ordered == vector<fs::path>({fillers.at(2), fillers.at(3), fillers.at(1), fillers.at(0)}));
+    fs::remove_all(dir.parent_path());
+}
+
+BOOST_AUTO_TEST_CASE(persistentCacheFile_mergeOnSave)
+{
+    namespace fs = boost::filesystem;
+    fs::path const dir = fs::temp_directory_path() / fs::unique_path();
+    fs::path const file = dir / "cache.json";
+
+    // Two instances saving different entries keep each other's entries, the later value of a key wins
+    PersistentCacheFile const first(file, "test cache", "1");
+    PersistentCacheFile const second(file, "test cache", "1");
+    DataObject a(DataType::Object);
+    a["a"] = 1;
+    a["b"] = 2;
+    BOOST_CHECK(first.save(a));
+    DataObject b(DataType::Object);
+    b["b"] = 3;
+    b["c"] = 4;
+    BOOST_CHECK(second.save(b));
+    spDataObject const entries = first.load();
+    BOOST_REQUIRE_EQUAL(entries->getSubObjects().size(), 3u);
+    BOOST_CHECK_EQUAL(entries->atKey("a").asInt(), 1);
+    BOOST_CHECK_EQUAL(entries->atKey("b").asInt(), 3);
+    BOOST_CHECK_EQUAL(entries->atKey("c").asInt(), 4);
+
+    // Rebuild drops the file entries, another version and a broken file are read as empty
+    BOOST_CHECK(first.save(b, true));
+    BOOST_CHECK_EQUAL(first.load()->getSubObjects().size(), 2u);
+    BOOST_CHECK_EQUAL(PersistentCacheFile(file, "test cache", "2").load()->getSubObjects().size(), 0u);
+    writeFile(file, string("{\"version\" : \"1\", \"entries\" : {"));
+    BOOST_CHECK_EQUAL(first.load()->getSubObjects().size(), 0u);
+
+    // No temp files are left
+    size_t files = 0;
+    for (fs::directory_iterator it(dir); it != fs::directory_iterator(); ++it)
+        files += it->path().extension() == ".tmp" ? 1 : 0;
+    BOOST_CHECK_EQUAL(files, 0u);
+    fs::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_CASE(fillerHashIndex_changedFiller)
+{
+    namespace fs = boost::filesystem;
+    fs::path const dir = fs::temp_directory_path() / fs::unique_path();
+    fs::create_directories(dir);
+    fs::path const filler = dir / "indexFiller.json";
+    writeFile(filler, string("{}"));
+    std::time_t const past = std::time(nullptr) - 100;
+    fs::last_write_time(filler, past);
+
+    h256 hash;
+    FillerHashIndex index(dir / "fillerhashes.json", true, false);
+    BOOST_CHECK(!index.find(filler, hash));
+    index.record(filler, h256(1));
+    BOOST_CHECK(index.find(filler, hash));
+    BOOST_CHECK(hash == h256(1));
+
+    // Same mtime but another size
+    writeFile(filler, string("{ }"));
+    fs::last_write_time(filler, past);
+    BOOST_CHECK(!index.find(filler, hash));
+
+    // Just modified fillers are not recorded, the next change may keep the mtime
+    writeFile(filler, string("{}"));
+    index.record(filler, h256(2));
+    BOOST_CHECK(!index.find(filler, hash));
+
+    // Without --hashindex nothing is taken from the index
+    writeFile(filler, string("{}"));
+    fs::last_write_time(filler, past);
+    index.record(filler, h256(3));
+    index.save();
+    FillerHashIndex disabled(dir / "fillerhashes.json", false, false);
+    BOOST_CHECK(!disabled.find(filler, hash));
+    FillerHashIndex nextRun(dir / "fillerhashes.json", true, false);
+    BOOST_CHECK(nextRun.find(filler, hash));
+    BOOST_CHECK(hash == h256(3));
+    fs::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_CASE(compileCache_storeAndFind)
+{
+    namespace fs = boost::filesystem;
+    using test::compiler::CompileCache;
+    fs::path const dir = fs::temp_directory_path() / fs::unique_path() / "compilecache";
+    string const source = "{ [[0]] 1 }";
+    string const key = CompileCache::makeKey("lllc Version: 0.1", "", source);
+    BOOST_CHECK(key != CompileCache::makeKey("lllc Version: 0.2", "", source));
+    BOOST_CHECK(key != CompileCache::makeKey("lllc Version: 0.1", "--evm-version london", source));
+    BOOST_CHECK(key != CompileCache::makeKey("lllc Version: 0.1" + source, "", ""));
+
+    string compiled;
+    CompileCache cache(dir, true);
+    BOOST_CHECK(!cache.find(key, compiled));
+    cache.store(key, "0x600160005500");
+    BOOST_CHECK(cache.find(key, compiled));
+    BOOST_CHECK_EQUAL(compiled, "0x600160005500");
+
+    // Parallel workers storing the same entry
+    vector<std::thread> threads;
+    for (size_t i = 0; i < 4; i++)
+        threads.emplace_back([&cache, &key]() { cache.store(key, "0x600160005500"); });
+    for (auto& th : threads)
+        th.join();
+    BOOST_CHECK(cache.find(key, compiled));
+    BOOST_CHECK_EQUAL(compiled, "0x600160005500");
+
+    // The next run reads the entry from disk, empty results of failed compilers are not kept
+    string const emptyKey = CompileCache::makeKey("lllc Version: 0.1", "", "{}");
+    cache.store(emptyKey, "0x");
+    cache.store(emptyKey, "");
+    CompileCache nextRun(dir, true);
+    BOOST_CHECK(nextRun.find(key, compiled));
+    BOOST_CHECK_EQUAL(compiled, "0x600160005500");
+    BOOST_CHECK(!nextRun.find(emptyKey, compiled));
+    BOOST_CHECK(!cache.find(emptyKey, compiled));
+
+    // Without --compilecache nothing is read from or written to disk
+    CompileCache memoryOnly(dir, false);
+    BOOST_CHECK(!memoryOnly.find(key, compiled));
+    memoryOnly.store(emptyKey + "1", "0x00");
+    BOOST_CHECK(memoryOnly.find(emptyKey + "1", compiled));
+    BOOST_CHECK(!nextRun.find(emptyKey + "1", compiled));
+    fs::remove_all(dir.parent_path());
+}
+
+BOOST_AUTO_TEST_CASE(testProfiler_nestedScopesAndExport)
+{
+    namespace fs = boost::filesystem;
+    fs::path const dir = fs::temp_directory_path() / fs::unique_path();
+    fs::create_directories(dir);
+    fs::path const file = dir / "profile.json";
+    string const profileArg = file.string();
+    const char* argv[] = {"./retesteth", "--", "--exectimeprofile", profileArg.c_str()};
+    TestOptions opt(std::size(argv), argv);
+    opt.overrideMainOptions();
+
+    // Tool time of another thread is not counted for the test of this thread
+    double const threadStart = TestProfiler::threadTime(ProfilePhase::ToolExecution);
+    std::thread other([]() {
+        ProfileScope profile(ProfilePhase::ToolExecution, "otherThreadCall");
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    });
+    other.join();
+    BOOST_CHECK_EQUAL(TestProfiler::threadTime(ProfilePhase::ToolExecution), threadStart);
+
+    {
+        ProfileScope outer(ProfilePhase::ToolExecution, "outerCall");
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        {
+            ProfileScope inner(ProfilePhase::ToolExecution, "innerCall");
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+    int64_t const threadUs = llround((TestProfiler::threadTime(ProfilePhase::ToolExecution) - threadStart) * 1000000);
+
+    TestProfiler::exportProfile(file);
+    spDataObject const trace = readJsonData(file);
+    BOOST_REQUIRE(trace->count("traceEvents"));
+    std::map<string, DataObject const*> events;
+    for (auto const& event : trace->atKey("traceEvents").getSubObjects())
+        if (event->atKey("ph").asString() == "X")
+            events[event->atKey("name").asString()] = &event.getCContent();
+    BOOST_REQUIRE(events.count("outerCall") && events.count("innerCall") && events.count("otherThreadCall"));
+    DataObject const& outer = *events.at("outerCall");
+    DataObject const& inner = *events.at("innerCall");
+
+    // Both scopes are exported on one track, the inner one within the outer one
+    BOOST_CHECK_EQUAL(outer.atKey("cat").asString(), "tool execution");
+    BOOST_CHECK_EQUAL(outer.atKey("tid").asInt(), inner.atKey("tid").asInt());
+    BOOST_CHECK(outer.atKey("tid").asInt() != events.at("otherThreadCall")->atKey("tid").asInt());
+    BOOST_CHECK(inner.atKey("ts").asInt() >= outer.atKey("ts").asInt());
+    BOOST_CHECK(inner.atKey("ts").asInt() + inner.atKey("dur").asInt() <= outer.atKey("ts").asInt() + outer.atKey("dur").asInt());
+    BOOST_CHECK(outer.atKey("args").count("test"));
+
+    // The nested scope is not counted in the thread time again
+    BOOST_CHECK_EQUAL(threadUs, outer.atKey("dur").asInt());
+    fs::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_CASE(testOutputTimer_countsWorkerToolTime)
+{
+    const char* argv[] = {"./retesteth", "--", "--exectimelog", "-j", "2"};
+    TestOptions opt(std::size(argv), argv);
+    opt.overrideMainOptions();
+
+    // The folder timer runs on this thread, while the tool calls of its tests and their shared helpers run on workers
+    TestOutputTimer const timer;
+    test::session::ThreadManager::addTask([]() {
+        ProfileScope profile(ProfilePhase::ToolExecution, "workerCall");
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    });
+    test::session::ThreadManager::addTask([]() {
+        test::session::ThreadManager::runShared(4, [](size_t) {
+            ProfileScope profile(ProfilePhase::ToolExecution, "sharedCall");
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        });
+    });
+    test::session::ThreadManager::joinThreads();
+    BOOST_CHECK_GE(timer.getT8NTime(), 0.012);
+}
+
+BOOST_AUTO_TEST_CASE(threadManager_runSharedStopsAfterFailure)
+{
+    vector<int> runs(5, 0);
+    auto job = [&runs](size_t _index) {
+        runs.at(_index)++;
+        if (_index == 2)
+            throw std::runtime_error("job 2 failed");
+    };
+    BOOST_CHECK_THROW(test::session::ThreadManager::runShared(runs.size(), job), std::runtime_error);
+    BOOST_CHECK(runs == vector<int>({1, 1, 1, 0, 0}));
+
+    runs.assign(5, 0);
+    test::session::ThreadManager::runShared(runs.size(), [&runs](size_t _index) { runs.at(_index)++; });
+    BOOST_CHECK(runs == vector<int>(5, 1));
+}
+
+BOOST_AUTO_TEST_CASE(threadManager_runSharedKeepsSerialOrder)
+{
+    const char* argv[] = {"./retesteth", "--", "-j", "4"};
+    TestOptions opt(std::size(argv), argv);
+    opt.overrideMainOptions();
+
+    // Fork x transaction runs of one test, done in any order by the workers
+    // and put into the filled output in the order of the serial run
+    vector<string> const forks = {"Berlin", "London", "Paris"};
+    size_t const txCount = 8;
+    vector<pair<string, size_t>> jobs;
+    for (auto const& fork : forks)
+        for (size_t tx = 0; tx < txCount; tx++)
+            jobs.emplace_back(fork, tx);
+
+    vector<string> results(jobs.size());
+    std::mutex mutex;
+    std::set<std::thread::id> helpersRun;
+    std::set<std::thread::id> helpersDone;
+    std::thread::id testThread;
+    vector<string> filled;
+    test::session::ThreadManager::addTask([&]() {
+        testThread = std::this_thread::get_id();
+        test::session::ThreadManager::runShared(
+            jobs.size(),
+            [&](size_t _index) {
+                std::this_thread::sleep_for(std::chrono::milliseconds((jobs.size() - _index) % 5));
+                results.at(_index) = jobs.at(_index).first + ":" + to_string(jobs.at(_index).second);
+                std::lock_guard<std::mutex> lock(mutex);
+                if (std::this_thread::get_id() != testThread)
+                    helpersRun.emplace(std::this_thread::get_id());
+            },
+            [&]() {
+                std::lock_guard<std::mutex> lock(mutex);
+                helpersDone.emplace(std::this_thread::get_id());
+            });
+        for (auto const& result : results)
+            filled.emplace_back(result);
+    });
+    test::session::ThreadManager::joinThreads();
+
+    BOOST_REQUIRE_EQUAL(filled.size(), jobs.size());
+    for (size_t i = 0; i < jobs.size(); i++)
+        BOOST_CHECK_EQUAL(filled.at(i), jobs.at(i).first + ":" + to_string(jobs.at(i).second));
+
+    // Every helper that took a run has cleaned up after it
+    BOOST_CHECK(helpersRun == helpersDone);
+    BOOST_CHECK(!helpersDone.count(testThread));
+}
+
+BOOST_AUTO_TEST_CASE(threadManager_joinThreadsRethrowsJobFailure)
+{
+    const char* argv[] = {"./retesteth", "--", "-j", "2"};
+    TestOptions opt(std::size(argv), argv);
+    opt.overrideMainOptions();
+
+    // The other jobs still run and the workers are stopped before the failure is rethrown
+    std::atomic<size_t> runs = 0;
+    for (size_t i = 0; i < 4; i++)
+        test::session::ThreadManager::addTask([&runs, i]() {
+            runs++;
+            if (i == 1)
+                throw std::runtime_error("job 1 failed");
+        });
+    BOOST_CHECK_THROW(test::session::ThreadManager::joinThreads(), std::runtime_error);
+    BOOST_CHECK_EQUAL(runs, 4u);
+
+    // Failure is reported once, the next run starts clean
+    test::session::ThreadManager::addTask([&runs]() { runs++; });
+    BOOST_CHECK_NO_THROW(test::session::ThreadManager::joinThreads());
+    BOOST_CHECK_EQUAL(runs, 5u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()